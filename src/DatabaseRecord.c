@@ -32,6 +32,31 @@
 **
 ** 22 Oct 2018: Rev 4.0 - IMiller
 **                      - Bug fix for Incidents on-board trains (Redmine Issue #1324)
+** 17 Oct 2026: Rev 5.1
+**                      - readInDBFile() reads the times of a record with parseTimestamp, moving
+**                        along the string instead of removing each time from the front of it
+**                      - DatabaseRecords and SummaryEmails hold the type id of their incident type.
+**                        addIncidentsToDatabaseList() takes the IncidentType and matches incidents
+**                        by type id, new records also get the IncidentType they are for
+**                      - addIncidentsToDatabaseList() tests the onboard bit of the compiled flags
+**                      - addIncidentsToDatabaseList() is given only the incidents of its type, from the
+**                        incident list partitioned by type id
+**                      - A DatabaseList keeps a hash table of its records by location and data, or by
+**                        CC number for onboard incident types. created findDatabaseRecord method,
+**                        addIncidentsToDatabaseList() looks the records of an incident up in it
+**                      - the times of a record are inserted into the array of its TimeList, only the
+**                        times of onboard incident types keep their location.
+**                        checkThresholdCondition() slides a block of positions along the array
+**                      - created findFirstThresholdMet method, it checks every threshold of a type
+**                        against a record in one sweep along its time list
+**                      - the time the thresholds of a record were checked up to is saved in the
+**                        database file with a key of the thresholds. findFirstThresholdMet() only
+**                        checks the blocks ending at newer times, updateDatabaseRecord() starts it
+**                        over if an older time is added
+**                      - the records of a type with thresholds checked on buckets of time keep a
+**                        TimeBuckets, saved in the database file. The time of each incident is
+**                        only kept as long as the other thresholds need it. created
+**                        checkBucketThresholdCondition method
 */
 
 // Initialize variables for DatabaseList
@@ -42,6 +67,103 @@ void createDatabaseList(struct DatabaseList* dbl) {
 	dbl->tail = dbl->head;
 	dbl->count = 0;
   dbl->isOnBoardIncident = FALSE;
+  dbl->table = NULL;
+  dbl->tableSize = 0;
+  dbl->thresholdKey = 0;
+  dbl->bucketMinutes = 0;
+  dbl->bucketSpanMinutes = 0;
+}
+
+// hash the key of a DatabaseRecord, its data for an onboard incident type or its
+// location and data otherwise
+//	dbl		- The Database List, isOnBoardIncident says which fields are the key
+//	location	- The location of the key
+//	data		- The data of the key
+//	return		- The hash
+static unsigned long hashDatabaseKey(struct DatabaseList* dbl, const char* location, const char* data) {
+  if(TRUE == dbl->isOnBoardIncident) {
+    return hashString(data);
+  }
+  // the ';' between them keeps "ab","c" apart from "a","bc"
+  return hashStringWithSeed(data, hashStringWithSeed(SEMI_COLON, hashString(location)));
+}
+
+// check if a DatabaseRecord has a key
+//	dbl		- The Database List, isOnBoardIncident says which fields are compared
+//	dr		- The DatabaseRecord
+//	location	- The location of the key
+//	data		- The data of the key
+//	return		- TRUE if the DatabaseRecord has the key, FALSE otherwise
+static BOOL databaseRecordHasKey(struct DatabaseList* dbl, struct DatabaseRecord* dr, const char* location, const char* data) {
+  if(TRUE == dbl->isOnBoardIncident) {
+    return strcmp(dr->data, data)==0;
+  }
+  return strcmp(dr->location, location)==0 && strcmp(dr->data, data)==0;
+}
+
+// find the slot of a key in the hash table, either the slot holding the first
+// DatabaseRecord with the key or the empty slot it would go in
+//	dbl		- The Database List
+//	location	- The location of the key
+//	data		- The data of the key
+//	return		- The slot
+static int findDatabaseSlot(struct DatabaseList* dbl, const char* location, const char* data) {
+  int slot = hashDatabaseKey(dbl, location, data) & (dbl->tableSize - 1);
+  while(dbl->table[slot] != NULL && !databaseRecordHasKey(dbl, dbl->table[slot], location, data)) {
+    slot = (slot + 1) & (dbl->tableSize - 1);
+  }
+  return slot;
+}
+
+// add a DatabaseRecord to the end of the chain of its key in the hash table
+//	dbl	- The Database List, with a table big enough for one more key
+//	dr	- The DatabaseRecord, the last in the list with its key
+//	return	- Void
+static void addToDatabaseTable(struct DatabaseList* dbl, struct DatabaseRecord* dr) {
+  dr->nextMatch = NULL;
+  int slot = findDatabaseSlot(dbl, dr->location, dr->data);
+  if(dbl->table[slot] == NULL) {
+    dbl->table[slot] = dr;
+  }
+  else {
+    struct DatabaseRecord* last = dbl->table[slot];
+    while(last->nextMatch != NULL) {
+      last = last->nextMatch;
+    }
+    last->nextMatch = dr;
+  }
+}
+
+// build the hash table of a Database List from every record in it, with room for
+// the list to double before it is built again
+//	dbl	- The Database List
+//	return	- Void
+static void indexDatabaseList(struct DatabaseList* dbl) {
+  free(dbl->table);
+  dbl->tableSize = DATABASE_TABLE_MIN_SIZE;
+  while(dbl->tableSize < 4*dbl->count) {
+    dbl->tableSize *= 2;
+  }
+  dbl->table = calloc(dbl->tableSize, sizeof(struct DatabaseRecord*));
+  struct DatabaseRecord* dr = dbl->head;
+  while(dr != NULL) {
+    addToDatabaseTable(dbl, dr);
+    dr = dr->next;
+  }
+}
+
+// Find the first DatabaseRecord with a key, the others with the same key follow
+// it along nextMatch in list order, so the first one found is the one a walk of
+// the list would have found first.
+//	dbl		- The Database List
+//	location	- The location to look for, not used for an onboard incident type
+//	data		- The data to look for
+//	return		- The first DatabaseRecord with the key, NULL if there is none
+struct DatabaseRecord* findDatabaseRecord(struct DatabaseList* dbl, const char* location, const char* data) {
+  if(dbl->table == NULL) {
+    indexDatabaseList(dbl);
+  }
+  return dbl->table[findDatabaseSlot(dbl, location, data)];
 }
 
 // Standard linked list, queue style, data is inserted at the end of the list,
@@ -61,32 +183,32 @@ void insertIntoDatabaseList(struct DatabaseList* dbl, struct DatabaseRecord* dr)
 		dbl->tail = dr;
 		dbl->count++;
 	}
+	// the table is built again once it is half full
+	if(dbl->table == NULL || 2*dbl->count > dbl->tableSize) {
+		indexDatabaseList(dbl);
+	}
+	else {
+		addToDatabaseTable(dbl, dr);
+	}
 }
 
 // 'updating' a databaseRecord means adding a new time to its timeList 
 // (likely one from an incident list, that was read in from a logfile)
-// also checks for duplicate times so the email message doesn't have 8-10 events that
-// happens at the same time (Current Bandaid Solution).
-//	dr	- The Database record in which the new time event will be added
-//	te	- The new time event to be added
-//	return	- Void
-void updateDatabaseRecord(struct DatabaseRecord* dr, struct TimeElement* te) {
-  	// insert new time into DatabaseRecord's TimeList
-	BOOL sameTime = FALSE;
-	struct TimeElement* recordedTimes = dr->timeList->head;
-	while(NULL != recordedTimes && FALSE != sameTime)
-	{
-		if(recordedTimes->timeObj == te->timeObj)
-		{
-			sameTime = TRUE;
-		}
-		recordedTimes = recordedTimes->next;
+//	dr		- The Database record in which the new time event will be added
+//	timeObj		- The time of the new event
+//	location	- The location of the new event, NULL if it is not kept
+//	return		- Void
+void updateDatabaseRecord(struct DatabaseRecord* dr, time_t timeObj, const char* location) {
+	// a time older than the thresholds were checked up to makes new blocks
+	// of times before it, they are checked again from the oldest time
+	if(timeObj <= dr->thresholdsCheckedTo) {
+		dr->thresholdsCheckedTo = 0;
 	}
-	//if an event at this time has not been recorded yet, add it to the list
-	if(FALSE == sameTime)
-	{
-		insert(dr->timeList, te);
+	if(dr->timeBuckets != NULL) {
+		addTimeToBuckets(dr->timeBuckets, timeObj);
 	}
+  	// insert new time into DatabaseRecord's TimeList
+	insertTime(dr->timeList, timeObj, location);
 }
 
 // Used for debugging purposes and user-side checks.
@@ -139,6 +261,9 @@ void printDatabaseList(struct DatabaseList* dbl) {
 //	dr	- ??? Probably supposed to be the reference to the removed database record
 //		  but isn't properly coded as such
 void removeFromDatabaseList(struct DatabaseList* dbl, struct DatabaseRecord* dr) {
+	// the table is built again when it is next needed
+	free(dbl->table);
+	dbl->table = NULL;
 	dr = dbl->head;
 	if(dbl->count > 1) {
 		dbl->head = dbl->head->next;
@@ -162,6 +287,9 @@ void removeFromDatabaseList(struct DatabaseList* dbl, struct DatabaseRecord* dr)
 //	dbl	- The database list who's head will be removed and it's memory freed
 //	return	- Void
 void removeAndDestroyDatabaseRecord(struct DatabaseList* dbl) {
+	// the table is built again when it is next needed
+	free(dbl->table);
+	dbl->table = NULL;
 	struct DatabaseRecord* dr = dbl->head;
 	if(dbl->count > 1) {
 		dbl->head = dbl->head->next;
@@ -178,6 +306,9 @@ void removeAndDestroyDatabaseRecord(struct DatabaseList* dbl) {
 		dbl->count=0; // just a precaution
 	}
         destroyTimeList(dr->timeList);
+        if(dr->timeBuckets != NULL) {
+          destroyTimeBuckets(dr->timeBuckets);
+        }
         free(dr->flag->msg);
         free(dr->flag);
 	free(dr->location);
@@ -230,6 +361,12 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
   char* extension = (char*)calloc(STRING_LENGTH, sizeof(char));
   constructLocalFilepath(extension, DATABASE_FILES, fileName, DOT_TXT);
   FILE *db = fopen(extension, "r");
+  dbl->thresholdKey = getThresholdListKey(incidentType->thresholdList);
+  dbl->bucketMinutes = getBucketMinutes(incidentType->thresholdList);
+  dbl->bucketSpanMinutes = getBucketExpiringTime(incidentType->thresholdList);
+  // the time of each incident is only kept as long as the thresholds that are
+  // not bucketed need it, the same as emailDelayTimeMinutes if none are
+  int timeExpiringMinutes = getTimeExpiringTime(incidentType->thresholdList);
   
   // If the database does not exist then return. One will be created near the
   // end of execution after new incidents have been merged with this 
@@ -264,6 +401,12 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
 	      dr->next = NULL;
               dr->lastSummaryEvent = (char*)calloc(STRING_LENGTH,sizeof(char));
 	      dr->incidentType = incidentType;   
+	      dr->typeId = incidentType->typeId;
+	      dr->thresholdMet = NULL;
+	      dr->thresholdStart = 0;
+	      dr->thresholdsCheckedTo = 0;
+	      dr->timeBuckets = dbl->bucketMinutes > 0 ?
+	        createTimeBuckets(dbl->bucketMinutes, dbl->bucketSpanMinutes) : NULL;
         //If onboard incident type
         if(TRUE == dbl->isOnBoardIncident)
         {
@@ -297,6 +440,33 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
         
         getCharsUpTo(tmp, dr->lastSummaryEvent, ";");
         removeFirstChars(tmp,strlen(dr->lastSummaryEvent)+1);
+
+        // the time the thresholds were checked up to, only written once they
+        // have been checked. It is not used if the thresholds have changed
+        if(strncmp(tmp, THRESHOLDS_CHECKED, strlen(THRESHOLDS_CHECKED)) == 0) {
+          char checkedField[STRING_LENGTH];
+          getCharsUpTo(tmp, checkedField, ";");
+          removeFirstChars(tmp, strlen(checkedField)+1);
+          char* checked;
+          unsigned long key = strtoul(checkedField + strlen(THRESHOLDS_CHECKED), &checked, 10);
+          if(key != dbl->thresholdKey || *checked != '-' ||
+            !parseTimestamp(checked + 1, &(dr->thresholdsCheckedTo), NULL)) {
+            dr->thresholdsCheckedTo = 0;
+          }
+        }
+
+        // the buckets of a type with bucketed thresholds. If they were not
+        // written out they are counted from the times that are read in
+        BOOL bucketsReadIn = FALSE;
+        if(strncmp(tmp, BUCKETS, strlen(BUCKETS)) == 0) {
+          char* bucketField = (char*)calloc(strlen(tmp) + 1, sizeof(char));
+          getCharsUpTo(tmp, bucketField, ";");
+          removeFirstChars(tmp, strlen(bucketField)+1);
+          if(dr->timeBuckets != NULL) {
+            bucketsReadIn = readTimeBuckets(dr->timeBuckets, bucketField + strlen(BUCKETS));
+          }
+          free(bucketField);
+        }
         
                 
         // swapped c for tmp
@@ -312,40 +482,42 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
         //If onboard incident
         if(TRUE == dbl->isOnBoardIncident)
         {
-          // split up timestr into a linked list of TimeElement structs. 
-          while( !(tmpTimeStr==NULL || strcmp(tmpTimeStr,"")==0) ) {
+          // split up timestr into the times of the TimeList.
+          // timeCursor is moved along the string rather than removing each
+          // time and location from the front of it
+          char* timeCursor = tmpTimeStr;
+          while( *timeCursor != '\0' ) {
             time_t tmpTime;
+            int timeLength = 0;
+            if(!parseTimestamp(timeCursor, &tmpTime, &timeLength)) {
+              printf("ERROR - could not read the time from %s\n", timeCursor);
+              break;
+            }
+            timeCursor += timeLength;
             char* tmp_loc = calloc(STRING_LENGTH, sizeof(char));
-            getDateFromString(tmpTimeStr, &tmpTime);
 
-            if(contains(tmpTimeStr, ","))
+            if(contains(timeCursor, ","))
             {
-              getCharsUpTo(tmpTimeStr, tmp_loc, ",");
-              removeFirstChars(tmpTimeStr, (strlen(tmp_loc) + 1));
+              getCharsUpTo(timeCursor, tmp_loc, ",");
+              timeCursor += strlen(tmp_loc) + 1;
             }
               //Else must be last location
             else
             {
-              strcpy(tmp_loc, tmpTimeStr);
-              removeFirstChars(tmpTimeStr, strlen(tmp_loc));
+              strcpy(tmp_loc, timeCursor);
+              timeCursor += strlen(tmp_loc);
+            }
+            if(dr->timeBuckets != NULL && !bucketsReadIn) {
+              addTimeToBuckets(dr->timeBuckets, tmpTime);
             }
 
             // If the incident happened within the email delay time from the 
             // current time than it is read in and kept.
             // else it is ignored.
-            if(tmpTime + emailDelayTimeMinutes*60 > time(NULL)- OFFSET*24*60*60) {
-              struct TimeElement* te = malloc(sizeof(struct TimeElement));
-              te->timeObj = tmpTime;
-              te->location = calloc(STRING_LENGTH, sizeof(char));
-              strcpy(te->location, tmp_loc);
-
-              insert(dr->timeList, te);
+            if(tmpTime + timeExpiringMinutes*60 > time(NULL)- OFFSET*24*60*60) {
+              insertTime(dr->timeList, tmpTime, tmp_loc);
               if(sendSummary) {
-                  struct TimeElement* sum = malloc(sizeof(struct TimeElement));
-                  sum->timeObj = tmpTime;
-                  sum->location = calloc(STRING_LENGTH, sizeof(char));
-                  strcpy(sum->location, tmp_loc);
-                  insert(summaryTimeList, sum);
+                  insertTime(summaryTimeList, tmpTime, tmp_loc);
               }
             }
             //it's expired and an email has been sent about the issue
@@ -356,34 +528,23 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
             else if(strcmp(tmpflag, NOEMAIL) != 0){
               if(!sendSummary) {
                 time_t lastSumTime;
-                char* tmp = (char*)calloc(STRING_LENGTH, sizeof(char));
-                strcpy(tmp, dr->lastSummaryEvent);
-                BOOL flag = getDateFromString(tmp, &lastSumTime);
+                BOOL flag = parseTimestamp(dr->lastSummaryEvent, &lastSumTime, NULL);
             
-                free(tmp);
                 //if flag is false, then a summary email has not been sent before
                 //if flag is true, an email has been sent before and therefore
                 //the time of the event being processed should be larger than
                 //the previous event processed by at least the email delay amount
                 if(!flag || lastSumTime + emailDelayTimeMinutes*60 < tmpTime) {
-                  struct TimeElement* te = malloc(sizeof(struct TimeElement));
-                  te->timeObj = tmpTime;
-                  te->location = calloc(STRING_LENGTH, sizeof(char));
-                  strcpy(te->location, tmp_loc);
-                  insert(summaryTimeList, te);
+                  insertTime(summaryTimeList, tmpTime, tmp_loc);
                   //insert time into database record
                   char* s;
-                  strcpy(dr->lastSummaryEvent,s = getStringFromDate(te->timeObj));
+                  strcpy(dr->lastSummaryEvent,s = getStringFromDate(tmpTime));
                   free(s);
                   sendSummary = TRUE;   
                 }
               }
               else {
-                  struct TimeElement* te = malloc(sizeof(struct TimeElement));
-                  te->timeObj = tmpTime;
-                  te->location = calloc(STRING_LENGTH, sizeof(char));
-                  strcpy(te->location, tmp_loc);
-                  insert(summaryTimeList, te);
+                  insertTime(summaryTimeList, tmpTime, tmp_loc);
               }
             }
             free(tmp_loc);
@@ -392,25 +553,29 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
           //Not an onboard incident
         else
         {
-          // split up timestr into a linked list of TimeElement structs.
-          while( !(tmpTimeStr==NULL || strcmp(tmpTimeStr,"")==0) ) {
+          // split up timestr into the times of the TimeList.
+          // timeCursor is moved along the string rather than removing each
+          // time from the front of it
+          char* timeCursor = tmpTimeStr;
+          while( *timeCursor != '\0' ) {
             time_t tmpTime;
-            getDateFromString(tmpTimeStr, &tmpTime);
+            int timeLength = 0;
+            if(!parseTimestamp(timeCursor, &tmpTime, &timeLength)) {
+              printf("ERROR - could not read the time from %s\n", timeCursor);
+              break;
+            }
+            timeCursor += timeLength;
+            if(dr->timeBuckets != NULL && !bucketsReadIn) {
+              addTimeToBuckets(dr->timeBuckets, tmpTime);
+            }
 
             // If the incident happened within the email delay time from the 
             // current time than it is read in and kept.
             // else it is ignored.
-            if(tmpTime + emailDelayTimeMinutes*60 > time(NULL)- OFFSET*24*60*60) {
-              struct TimeElement* te = malloc(sizeof(struct TimeElement));
-              te->timeObj = tmpTime;
-              te->location = calloc(STRING_LENGTH, sizeof(char));
-
-              insert(dr->timeList, te);
+            if(tmpTime + timeExpiringMinutes*60 > time(NULL)- OFFSET*24*60*60) {
+              insertTime(dr->timeList, tmpTime, NULL);
               if(sendSummary) {
-                  struct TimeElement* sum = malloc(sizeof(struct TimeElement));
-                  sum->timeObj = tmpTime;
-                  sum->location = calloc(STRING_LENGTH, sizeof(char));
-                  insert(summaryTimeList, sum);
+                  insertTime(summaryTimeList, tmpTime, NULL);
               }
             }
             //it's expired and an email has been sent about the issue
@@ -421,32 +586,23 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
             else if(strcmp(tmpflag, NOEMAIL) != 0){
               if(!sendSummary) {
                 time_t lastSumTime;
-                char* tmp = (char*)calloc(STRING_LENGTH, sizeof(char));
-                strcpy(tmp, dr->lastSummaryEvent);
-                BOOL flag = getDateFromString(tmp, &lastSumTime);
+                BOOL flag = parseTimestamp(dr->lastSummaryEvent, &lastSumTime, NULL);
             
-                free(tmp);
                 //if flag is false, then a summary email has not been sent before
                 //if flag is true, an email has been sent before and therefore
                 //the time of the event being processed should be larger than
                 //the previous event processed by at least the email delay amount
                 if(!flag || lastSumTime + emailDelayTimeMinutes*60 < tmpTime) {
-                  struct TimeElement* te = malloc(sizeof(struct TimeElement));
-                  te->timeObj = tmpTime;
-                  te->location = calloc(STRING_LENGTH, sizeof(char));
-                  insert(summaryTimeList, te);
+                  insertTime(summaryTimeList, tmpTime, NULL);
                   //insert time into database record
                   char* s;
-                  strcpy(dr->lastSummaryEvent,s = getStringFromDate(te->timeObj));
+                  strcpy(dr->lastSummaryEvent,s = getStringFromDate(tmpTime));
                   free(s);
                   sendSummary = TRUE;   
                 }
               }
               else {
-                  struct TimeElement* te = malloc(sizeof(struct TimeElement));
-                  te->timeObj = tmpTime;
-                  te->location = calloc(STRING_LENGTH, sizeof(char));
-                  insert(summaryTimeList, te);
+                  insertTime(summaryTimeList, tmpTime, NULL);
               }
             }
           }
@@ -464,19 +620,13 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
             se->emailFileName = (char*)calloc(STRING_LENGTH, sizeof(char));
             
             strcpy(se->typeOfIncident, dr->typeOfIncident);
+            se->typeId = dr->typeId;
             strcpy(se->data, dr->data);
             strcpy(se->location, dr->location);
 	    strcpy(se->extra,dr->extra);
             strcpy(se->other, dr->other);
         
             se->tl = summaryTimeList;
-	    	//clear duplicate events form the summary list
-		//struct TimeElement* timeElement = se->tl->head;
-		//while(timeElement != NULL)
-		//{
-		//	RemoveDupTime(se->tl,timeElement->timeObj);
-		//	timeElement = timeElement->next;
-		//}
             se->next = NULL;
  
             
@@ -532,10 +682,16 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
           }
         }
 
+        // the buckets that are older than the buckets cover are emptied
+        if(dr->timeBuckets != NULL) {
+          advanceTimeBuckets(dr->timeBuckets, time(NULL) - OFFSET*24*60*60);
+        }
+
         // with 'expired' times not being included, the timeList could be empty
         // if so the entire DatabaseRecord may be destroy, if not, the record
-        // is added to the DatabaseRecord List        
-        if(dr->timeList->count > 0 && reset==FALSE) {
+        // is added to the DatabaseRecord List. A record with incidents left in
+        // its buckets is kept        
+        if((dr->timeList->count > 0 || (dr->timeBuckets != NULL && dr->timeBuckets->total > 0)) && reset==FALSE) {
           insertIntoDatabaseList(dbl, dr);
         }
         else
@@ -551,6 +707,9 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
           free(dr->next);
           free(dr->typeOfIncident);
           destroyTimeList(dr->timeList);
+          if(dr->timeBuckets != NULL) {
+            destroyTimeBuckets(dr->timeBuckets);
+          }
           free(dr);
         }
         tmp = (char*)realloc(tmp, STRING_LENGTH);
@@ -569,6 +728,26 @@ void readInDBFile(char* fileName, struct DatabaseList* dbl,
   }
 }
 
+// write the time the thresholds of a record were checked up to and the key of
+// the thresholds into the database file, nothing if they have not been checked.
+// Then the buckets of time of the record, if it has them.
+//	outputDb	- The database file being written
+//	dbl		- The Database List the record is in
+//	dr		- The Database Record being written
+//	return		- Void
+static void printThresholdState(FILE* outputDb, struct DatabaseList* dbl, struct DatabaseRecord* dr) {
+  if(dr->thresholdsCheckedTo != 0) {
+    char* s; //tmp variable for getStringFromDate
+    fprintf(outputDb, "%s%lu-%s;", THRESHOLDS_CHECKED, dbl->thresholdKey, s = getStringFromDate(dr->thresholdsCheckedTo));
+    free(s);
+  }
+  if(dr->timeBuckets != NULL) {
+    fprintf(outputDb, "%s", BUCKETS);
+    printTimeBuckets(outputDb, dr->timeBuckets);
+    fprintf(outputDb, ";");
+  }
+}
+
 // Method to take in a linked-list of DatabaseRecords and format them into
 // a structured output file. The original database file will be renamed to include
 // a datastamp of the current time.
@@ -629,6 +808,7 @@ void printDatabaseToFile(char* typeOfIncident, struct DatabaseList* dbl) {
         {
 	//fprintf(outputDb, "CC: %s;%s;%s;%s;%s;%s;", dr->data, dr->other, dr->extra, dr->typeOfIncident, dr->flag->msg, dr->lastSummaryEvent);
           fprintf(outputDb, "CC: %s;%s;%s;%s;%s;%s;%s;", dr->data, dr->other, dr->extra, dr->subwayLine, dr->typeOfIncident, dr->flag->msg, dr->lastSummaryEvent);
+          printThresholdState(outputDb, dbl, dr);
           printOnboardTimeList(outputDb, dr->timeList);
         }
         else
@@ -637,6 +817,7 @@ void printDatabaseToFile(char* typeOfIncident, struct DatabaseList* dbl) {
           fprintf(outputDb, "CC: %s;%s;%s;%s;%s;%s-%s;%s;", dr->data, dr->other, dr->extra, dr->subwayLine, dr->typeOfIncident, dr->flag->msg,s = getStringFromDate(dr->flag->timeOfEmail), dr->lastSummaryEvent);
 	//fprintf(outputDb, "CC: %s;%s;%s;%s;%s-%s;%s;", dr->data, dr->other, dr->extra, dr->typeOfIncident, dr->flag->msg,s = getStringFromDate(dr->flag->timeOfEmail), dr->lastSummaryEvent);
           free(s);
+          printThresholdState(outputDb, dbl, dr);
           printOnboardTimeList(outputDb, dr->timeList);
         }
         dr=dr->next;
@@ -651,6 +832,7 @@ void printDatabaseToFile(char* typeOfIncident, struct DatabaseList* dbl) {
         {
           fprintf(outputDb, "%s;%s;%s;%s;%s;%s;%s;%s;", dr->location, dr->data, dr->other, dr->extra, dr->subwayLine, dr->typeOfIncident, dr->flag->msg, dr->lastSummaryEvent);
 	//fprintf(outputDb, "%s;%s;%s;%s;%s;%s;%s;", dr->location, dr->data, dr->other, dr->extra, dr->typeOfIncident, dr->flag->msg, dr->lastSummaryEvent);
+          printThresholdState(outputDb, dbl, dr);
           printTimeList(outputDb, dr->timeList);
         }
         else
@@ -659,6 +841,7 @@ void printDatabaseToFile(char* typeOfIncident, struct DatabaseList* dbl) {
           //fprintf(outputDb, "%s;%s;%s;%s;%s;%s-%s;%s;", dr->location, dr->data, dr->other, dr->extra, dr->typeOfIncident, dr->flag->msg,s = getStringFromDate(dr->flag->timeOfEmail), dr->lastSummaryEvent);
 	fprintf(outputDb, "%s;%s;%s;%s;%s;%s;%s-%s;%s;", dr->location, dr->data, dr->other, dr->extra, dr->subwayLine, dr->typeOfIncident, dr->flag->msg,s = getStringFromDate(dr->flag->timeOfEmail), dr->lastSummaryEvent);
           free(s);
+          printThresholdState(outputDb, dbl, dr);
           printTimeList(outputDb, dr->timeList);
         }
         dr=dr->next;
@@ -688,50 +871,139 @@ void printDatabaseToFile(char* typeOfIncident, struct DatabaseList* dbl) {
 
 // This method will cycle through a DatabaseRecord's timelist and see if any
 // pattern of times satisfies a particular threshold condition of X times in
-// Y hours.
+// Y hours. A block of 'numOfIncidents' times is slid along the list, its
+// first and last times are compared.
 //	th	- The Threshold to be checked
 //	dr	- The Database Record being checked to see if it triggered a threshold
-//	a	- The time list to be check
+//	a	- Set to the position in the time list of the first time of the block
 //	return	- An int that indicates whether or not the threshold condition was met
-int checkThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, struct TimeElement** a) {
+int checkThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, int* a) {
   // If there are not enough times then they cannot possibly meet threshold
   if( dr->timeList->count < th->numOfIncidents ) {
     return NO_CONDITION_MET;
   }
   else {
-    *a = (dr->timeList->head); // a is first time in range
-    struct TimeElement* b = dr->timeList->head; // b is last time in range
-    int i=1;
-    for(i; i<th->numOfIncidents && b!=NULL; i++) {
-
-      b = b->next; 
-    } // we now have a block with a length of 'numOfIncidents'
-    
-    while(b!=NULL){
-      if( b->timeObj - (*a)->timeObj < (th->numOfMinutes)*60 ) {
+    // b is last time in range, we have a block with a length of 'numOfIncidents'
+    int b = th->numOfIncidents > 0 ? th->numOfIncidents - 1 : 0;
+    for(*a = 0; b < dr->timeList->count; (*a)++, b++) {
+      if( getTime(dr->timeList, b) - getTime(dr->timeList, *a) < (th->numOfMinutes)*60 ) {
       	return CONDITION_MET;
       }
-      *a = ((*a)->next);
-      b = b->next;
     }
-    // If b is now the last element in the list and no condition has been met,
+    // If b is now past the last element in the list and no condition has been met,
     // then return NO_CONDITION_MET
     return NO_CONDITION_MET;
   }
   return NO_CONDITION_MET;
 }
+// Check a threshold on the TimeBuckets of a DatabaseRecord instead of on its
+// times. The threshold is met if the incidents in k buckets in a row reach
+// 'numOfIncidents', where k is 'numOfMinutes' divided by the size of a bucket
+// and rounded up. Incidents are only known to the bucket, so k buckets hold
+// incidents up to one bucket more than 'numOfMinutes' apart. The threshold can
+// be met by incidents up to one bucket further apart than it allows, and can be
+// missed for incidents up to one bucket closer together than it allows.
+//	th	- The Threshold to be checked, a bucketed one
+//	dr	- The Database Record being checked
+//	a	- Set to the position in the time list of the first time kept from the
+//		  buckets that met the threshold, there may be fewer than
+//		  'numOfIncidents' times kept from them
+//	return	- An int that indicates whether or not the threshold condition was met
+int checkBucketThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, int* a) {
+  struct TimeBuckets* tb = dr->timeBuckets;
+  if(tb == NULL || tb->total < th->numOfIncidents || tb->total == 0) {
+    return NO_CONDITION_MET;
+  }
+  int k = (th->numOfMinutes + tb->bucketMinutes - 1)/tb->bucketMinutes;
+  if(k < 1) {
+    k = 1;
+  }
+  if(k > tb->bucketCount) {
+    k = tb->bucketCount;
+  }
+  // the sum of the k buckets ending at i
+  int sum = 0;
+  int i;
+  for(i = 0; i < tb->bucketCount; i++) {
+    sum += getBucketCount(tb, i);
+    if(i >= k) {
+      sum -= getBucketCount(tb, i - k);
+    }
+    if(i >= k - 1 && sum > 0 && sum >= th->numOfIncidents) {
+      time_t windowStart = getBucketStart(tb, i - k + 1);
+      *a = 0;
+      while(*a < dr->timeList->count && getTime(dr->timeList, *a) < windowStart) {
+        (*a)++;
+      }
+      return CONDITION_MET;
+    }
+  }
+  return NO_CONDITION_MET;
+}
+
+// Find the first threshold of a ThresholdList, in list order, that a
+// DatabaseRecord's times meet. This is the threshold checkThresholdCondition
+// would find first if it was called for each threshold in turn, but the time
+// list is only swept once. b is moved along the list and for each threshold
+// the block of 'numOfIncidents' times ending at b is checked, so the first b a
+// threshold is met at gives its first block. Only thresholds before the one
+// found so far are checked, and the sweep ends once the first one is met.
+// The sweep starts at the first time newer than dr->thresholdsCheckedTo, the
+// blocks ending before it were checked on an earlier run and met no threshold.
+// Bucketed thresholds are left out of the sweep and checked on the buckets of
+// the record afterwards.
+//	thresholdList	- The thresholds of the record's incident type
+//	dr		- The Database Record being checked
+//	a		- Set to the position in the time list of the first time of the
+//			  block that met the threshold
+//	return		- The threshold that was met, NULL if none were
+struct Threshold* findFirstThresholdMet(struct ThresholdList* thresholdList, struct DatabaseRecord* dr, int* a) {
+  struct Threshold* met = NULL;
+  int metIndex = thresholdList->count;
+  int b = dr->timeList->count;
+  while(b > 0 && getTime(dr->timeList, b - 1) > dr->thresholdsCheckedTo) {
+    b--;
+  }
+  for(; b < dr->timeList->count && metIndex > 0; b++) {
+    struct Threshold* th = thresholdList->head;
+    int i;
+    for(i = 0; th != NULL && i < metIndex; i++) {
+      // the block of 'numOfIncidents' times ending at b
+      int first = b - (th->numOfIncidents > 0 ? th->numOfIncidents - 1 : 0);
+      if( th->bucketMinutes == 0 && first >= 0 && getTime(dr->timeList, b) - getTime(dr->timeList, first) < (th->numOfMinutes)*60 ) {
+        met = th;
+        metIndex = i;
+        *a = first;
+        break;
+      }
+      th = th->next;
+    }
+  }
+
+  // the thresholds checked on buckets of time, before the one found so far
+  struct Threshold* th = thresholdList->head;
+  int i;
+  for(i = 0; th != NULL && i < metIndex; i++) {
+    if(th->bucketMinutes > 0 && checkBucketThresholdCondition(th, dr, a) == CONDITION_MET) {
+      return th;
+    }
+    th = th->next;
+  }
+  return met;
+}
+
 // This method will cycle through a DatabaseRecord's timelist and see if any
 // pattern of times satisfies a particular threshold condition of X times in
 // Y hours for summary emails.
 //	th	- The threshold to be checked for
 //	dr	- The Database Record to be checked
-//	a	- The Database Record's time element list's head.
+//	a	- Set to the position in the time list of the first time of the block
 //	return	- An int that indictates whether or not the threshold email summary condition has been met
-int checkSummaryThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, struct TimeElement** a) {
+int checkSummaryThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, int* a) {
     int condition = checkThresholdCondition(th,dr,a);
     //if threshold condition is met, also check that the ENTIRE timelist fits the timespan
     if(CONDITION_MET == condition) {
-        int timeDiff = difftime(dr->timeList->tail->timeObj, dr->timeList->head->timeObj);
+        int timeDiff = difftime(getTime(dr->timeList, dr->timeList->count - 1), getTime(dr->timeList, 0));
         printf("timediff %d", timeDiff);
         //timeDiff is in seconds, convert to minutes
         if(abs(timeDiff)/60.0 > th->numOfMinutes) {
@@ -758,114 +1030,106 @@ int checkEmailStatus(struct DatabaseRecord* dr) {
   }
 }
 
-// This method is called to add all of the incidents in the incident list of
-// a certain type to the database list for that same type. The database list will
+// This method is called to add the incidents of a certain type to the database
+// list for that same type. The incidents are the slice of the incident list for
+// the type id, so no other type has to be skipped over. The database list will
 // have been read in from the database file (see ./Database_Files")
-//	typeOfIncident	- The short name for the type of incident thats being looked for
+//	incidentType	- The type of incident thats being looked for
 //	dbl		- The Database List to have matching incidents added to
-//	il		- The Incident List to be looked through to find matching incidents
-void addIncidentsToDatabaseList(char* typeOfIncident, struct DatabaseList* dbl, 
-  struct IncidentList* il) {
-  struct Incident* in = il->head;
+//	incidents	- The incidents of the type, in the order they were read in
+//	count		- The number of incidents
+void addIncidentsToDatabaseList(struct IncidentType* incidentType, struct DatabaseList* dbl, 
+  struct Incident** incidents, int count) {
+  int i;
   
-  // While loop to cycle through incident List
-  while(in != NULL) 
+  // for loop to cycle through the incidents of this type
+  for(i = 0; i < count; i++) 
   {
-    // Only add the matching type of incident, other types are ignored and will be added to a different
-	  // database list
-    if(strcmp(in->incidentType->typeOfIncident,typeOfIncident)==0)
+    struct Incident* in = incidents[i];
+
+    // the records with the same key as the incident, in list order
+    struct DatabaseRecord* tmp = findDatabaseRecord(dbl, in->location, in->data);
+    BOOL found = FALSE;
+    
+    // This time will either be added to a list or inserted alone into a new
+    // db object if no matching db record exists. Only the times of onboard
+    // incidents keep their location, it is written out with them.
+    time_t timeObj = in->timeElement->timeObj;
+    const char* timeLocation = (in->incidentType->flags & ONBOARD_INCIDENT_BIT) ? in->location : NULL;
+    
+    //If it's an Onboard Incident (Redmine Issue #1324) 
+    if(in->incidentType->flags & ONBOARD_INCIDENT_BIT)
     {
-        
-      struct DatabaseRecord* tmp = dbl->head;
-      BOOL found = FALSE;
-      
-      // This time element will either be added to a list or inserted alone into
-      // a new db object if no matching db record exists.
-      struct TimeElement* te = malloc(sizeof(struct TimeElement));
-      te->timeObj = in->timeElement->timeObj;
-      te->location = calloc(STRING_LENGTH, sizeof(char));
-      strcpy(te->location, in->location);
-      te->next = NULL;
-      
-      //If it's an Onboard Incident (Redmine Issue #1324) 
-      if(contains(in->incidentType->processingFlags, ONBOARD_INCIDENT_FLAG))
+      //The table is keyed by CC Number only, the first record found matches
+      if(NULL != tmp)
       {
-        //Loop through DB Records searching for CC Number only
-        while((NULL != tmp) && (FALSE == found))
-        {
-          found = (strcmp(tmp->data, in->data) == 0);    //CC Number
-
-          if(found)
-          {
-            updateDatabaseRecord(tmp, te);
-          }
-
-          tmp = tmp->next;
-        } //end of CC searching while loop
+        found = TRUE;
+        updateDatabaseRecord(tmp, timeObj, timeLocation);
       }
-      else
-      { //Not an onboard incident
+    }
+    else
+    { //Not an onboard incident
 
-        // While loop to cycle through database list, searching for pre-existing
-        // records of incidents at this location.
-        while((NULL != tmp) && (FALSE == found))
+      // While loop to cycle through the records with the same location and
+      // data as the incident, searching for a pre-existing record of it.
+      while((NULL != tmp) && (FALSE == found))
+      {
+        //since alot of the new incidents also use other, match for other aswell
+        BOOL otherMatch = TRUE;
+        if(*(in->other) != '\0')
         {
-          // Compare data to see if incident matches on already in database list
-          // some incidents may have NULL location, so they must be handled
-          BOOL locMatch = strcmp(tmp->location, in->location)==0;
-          BOOL dataMatch = strcmp(tmp->data, in->data)==0;
-
-          //since alot of the new incidents also use other, match for other aswell
-          BOOL otherMatch = TRUE;
-          if(*(in->other) != '\0')
-          {
-            otherMatch = strcmp(tmp->other,in->other)==0;
-          }
+          otherMatch = strcmp(tmp->other,in->other)==0;
+        }
 
-          found = otherMatch && locMatch && dataMatch;
-          
-          if(found) 
-          {
-            // simply adds a time to the timeList object of
-            // the DatabaseRecord object 'tmp'
-            updateDatabaseRecord(tmp, te);
-          }
-          tmp = tmp->next;
-        } // end of database list searching while loop
-      }
-      
-      // If the while loop has finished searching the database list and no
-      // existing database record matches the incident 'in' of incidentList 'il'
-      // then a new databaseRecord is created and added to the database list with
-      // the new time (see 'te')
-      if(!found)
-      {
-        struct DatabaseRecord* dr = malloc(sizeof(struct DatabaseRecord));
-        dr->timeList = malloc(sizeof(struct TimeList));
-          createTimeList(dr->timeList);
-        dr->location = (char*)calloc(STRING_LENGTH, sizeof(char));
-        dr->data = (char*)calloc(STRING_LENGTH, sizeof(char));
-        dr->typeOfIncident = (char*)calloc(STRING_LENGTH, sizeof(char));
-        dr->other = (char*)calloc(STRING_LENGTH, sizeof(char));
+        found = otherMatch;
+        
+        if(found) 
+        {
+          // simply adds a time to the timeList object of
+          // the DatabaseRecord object 'tmp'
+          updateDatabaseRecord(tmp, timeObj, timeLocation);
+        }
+        tmp = tmp->nextMatch;
+      } // end of database list searching while loop
+    }
+    
+    // If the while loop has finished searching the database list and no
+    // existing database record matches the incident 'in' of 'incidents'
+    // then a new databaseRecord is created and added to the database list with
+    // the new time (see 'timeObj')
+    if(!found)
+    {
+      struct DatabaseRecord* dr = malloc(sizeof(struct DatabaseRecord));
+      dr->timeList = malloc(sizeof(struct TimeList));
+        createTimeList(dr->timeList);
+      dr->location = (char*)calloc(STRING_LENGTH, sizeof(char));
+      dr->data = (char*)calloc(STRING_LENGTH, sizeof(char));
+      dr->typeOfIncident = (char*)calloc(STRING_LENGTH, sizeof(char));
+      dr->other = (char*)calloc(STRING_LENGTH, sizeof(char));
 	      dr->extra = calloc(STRING_LENGTH,sizeof(char));
 	dr->subwayLine = (char*)calloc(LINE_LENGTH,sizeof(char));
-        dr->flag = malloc(sizeof(struct Flag));
-        dr->flag->msg = (char*)calloc(STRING_LENGTH, sizeof(char));
-        dr->next = NULL;
-        dr->lastSummaryEvent = (char*)calloc(STRING_LENGTH, sizeof(char));
-    
-        insert(dr->timeList, te);
-        strcpy(dr->location, in->location);
-        strcpy(dr->data, in->data);
-        strcpy(dr->other, in->other);
+      dr->flag = malloc(sizeof(struct Flag));
+      dr->flag->msg = (char*)calloc(STRING_LENGTH, sizeof(char));
+      dr->next = NULL;
+      dr->lastSummaryEvent = (char*)calloc(STRING_LENGTH, sizeof(char));
+      dr->incidentType = incidentType;
+      dr->typeId = incidentType->typeId;
+      dr->thresholdMet = NULL;
+      dr->thresholdStart = 0;
+      dr->thresholdsCheckedTo = 0;
+      dr->timeBuckets = dbl->bucketMinutes > 0 ?
+        createTimeBuckets(dbl->bucketMinutes, dbl->bucketSpanMinutes) : NULL;
+  
+      updateDatabaseRecord(dr, timeObj, timeLocation);
+      strcpy(dr->location, in->location);
+      strcpy(dr->data, in->data);
+      strcpy(dr->other, in->other);
 	      strcpy(dr->extra, in->extra);
 	strcpy(dr->subwayLine, in->subwayLine);
-        strcpy(dr->typeOfIncident, in->incidentType->typeOfIncident);
-        strcpy(dr->flag->msg, NOEMAIL);
-        strcpy(dr->lastSummaryEvent, "NA");
-        insertIntoDatabaseList(dbl, dr);
-      }
+      strcpy(dr->typeOfIncident, in->incidentType->typeOfIncident);
+      strcpy(dr->flag->msg, NOEMAIL);
+      strcpy(dr->lastSummaryEvent, "NA");
+      insertIntoDatabaseList(dbl, dr);
     }
-    in = in->next;
-  } //  end of incidentList searching while loop
+  } //  end of incidents for loop
 }
@@ -4,6 +4,9 @@
 
 #define EMAIL "EMAIL" // A string used when printing information to the database
 #define NOEMAIL "NOEMAIL" // A string used when printing information to the database
+#define THRESHOLDS_CHECKED "CHECKED-" // A string used when printing the time the thresholds
+  // of a record were checked up to to the database, followed by the key of the thresholds
+#define BUCKETS "BUCKETS-" // A string used when printing the TimeBuckets of a record to the database
 
 #define NO_CONDITION_MET 100 // Threshold condition was not met
 #define CONDITION_MET 101 // Threshold condition was met
@@ -13,6 +16,8 @@
 #define EMAIL_NOT_SENT_YET 200 // An email has not been sent about this record
 #define EMAIL_ALREADY_SENT 201 // An email has already been sent about this record
 
+#define DATABASE_TABLE_MIN_SIZE 16 // smallest number of slots in the hash table of a DatabaseList
+
 /*
 ** Structures
 ** -----------------------------------------------------
@@ -33,9 +38,21 @@ struct Flag {
 // location is the location of the incident, usually a station or interlocking
 // data is the track name, or switch name, or sever name
 // other contains additional information - for CTDF, this is the run number of the train
+// typeId is the type id of the incidentType, types are compared by it
 // flag will indicate if an email has been sent and if so, when
 // timeList will be a list of all times that this incident occurred as
 // next is a pointer to the next element in the linked  list
+// nextMatch is the next DatabaseRecord in the list with the same key, see DatabaseList
+// thresholdMet is the first threshold of its type that the times meet, NULL if
+  // none is met or an email has already been sent. Set by determineBgnEndIncidents
+// thresholdStart is the position in timeList of the first time of the block
+  // that met thresholdMet
+// thresholdsCheckedTo is the newest time of timeList that the thresholds have
+  // been checked up to. No block of times ending at it or before it meets a
+  // threshold, so only the blocks ending at newer times are checked. 0 if the
+  // thresholds have to be checked from the oldest time
+// timeBuckets is the number of incidents in each bucket of time, for the
+  // thresholds checked on buckets. NULL if the type has no bucketed thresholds
 struct DatabaseRecord {
 	bool lastRecord;
 	char* location;
@@ -46,9 +63,15 @@ struct DatabaseRecord {
         char* typeOfIncident;
         char* lastSummaryEvent;
         struct IncidentType* incidentType;
+	int typeId;
 	struct Flag* flag; 
 	struct TimeList* timeList;
 	struct DatabaseRecord* next;
+	struct DatabaseRecord* nextMatch;
+	struct Threshold* thresholdMet;
+	int thresholdStart;
+	time_t thresholdsCheckedTo;
+	struct TimeBuckets* timeBuckets;
 };
 
 // contain for a linked-list of DatabaseRecords
@@ -56,12 +79,27 @@ struct DatabaseRecord {
 // head is the first element
 // tail is the last element
 // count will be the number of elements
+// table is a hash table of the records by key, their CC number (data) for an
+  // onboard incident type and their location and data otherwise. Each slot holds
+  // the first record with a key or NULL, the rest follow it along nextMatch in
+  // list order. It is kept up to date by insertIntoDatabaseList and is NULL
+  // until the first record is inserted or after a record is removed
+// tableSize is the number of slots in table, a power of two
+// thresholdKey is the key of the thresholds of the incident type, see
+  // getThresholdListKey. thresholdsCheckedTo read in with another key is not used
+// bucketMinutes is the size of the TimeBuckets of the records, 0 if they have none
+// bucketSpanMinutes is the number of minutes the TimeBuckets of the records cover
 struct DatabaseList {
 	struct DatabaseRecord* head;
 	struct DatabaseRecord* tail;
 	int count;
 	bool headerExists;
   	BOOL isOnBoardIncident;
+	struct DatabaseRecord** table;
+	int tableSize;
+	unsigned long thresholdKey;
+	int bucketMinutes;
+	int bucketSpanMinutes;
 };
 
 /*
@@ -79,7 +117,7 @@ void insertIntoDatabaseList(struct DatabaseList* dbl,
   
 // 'updating' a databaseRecord means adding a new time to its timeList 
 // (likely one from an incident list, that was read in from a logfile)
-void updateDatabaseRecord(struct DatabaseRecord* dr, struct TimeElement* te);
+void updateDatabaseRecord(struct DatabaseRecord* dr, time_t timeObj, const char* location);
 
 // Used for debugging purposes and user-side checks.
 // prints list in user-friendly way
@@ -98,6 +136,10 @@ void removeAndDestroyDatabaseRecord(struct DatabaseList* dbl);
 
 int getCountOfDatabaseList(struct DatabaseList* dbl);
 
+// Find the first DatabaseRecord with a key, the others with the same key follow
+// it along nextMatch. location is not used for an onboard incident type
+struct DatabaseRecord* findDatabaseRecord(struct DatabaseList* dbl, const char* location, const char* data);
+
 // recursively calls removeAndDestroyDatabaseRecord until list is empty and
 // then deletes the list itself
 void destroyDatabaseList(struct DatabaseList* dbl);
@@ -122,14 +164,21 @@ void printDatabaseToFile(char* typeOfIncident, struct DatabaseList* dbl);
 // This method will cycle through a DatabaseRecord's timelist and see if any
 // pattern of times satisfies a particular threshold condition of X times in
 // Y hours.
-int checkThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, struct TimeElement** a);
+int checkThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, int* a);
+
+// check a threshold on the TimeBuckets of a DatabaseRecord
+int checkBucketThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, int* a);
+
+// find the first threshold of a ThresholdList that a DatabaseRecord's times
+// meet, every threshold is checked in the same sweep along the time list
+struct Threshold* findFirstThresholdMet(struct ThresholdList* thresholdList, struct DatabaseRecord* dr, int* a);
 
 //for checking threshold for a summary email - additional restrictions apply
-int checkSummaryThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, struct TimeElement** a);
+int checkSummaryThresholdCondition(struct Threshold* th, struct DatabaseRecord* dr, int* a);
 
 // Check if a DatabaseRecord has been emailed about or no
 int checkEmailStatus(struct DatabaseRecord* dr);
-// This method is called to add all of the incidents in the incident list of
-// a certain type to the database list for that same type. The database list will
+// This method is called to add the incidents of a certain type, taken from
+// the partitioned incident list, to the database list for that same type. The database list will
 // have been read in from the database file (see ./Database_Files")
-void addIncidentsToDatabaseList(char* typeOfIncident, struct DatabaseList* dbl, struct IncidentList* il);
+void addIncidentsToDatabaseList(struct IncidentType* incidentType, struct DatabaseList* dbl, struct Incident** incidents, int count);
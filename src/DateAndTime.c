@@ -20,50 +20,173 @@
  *                          YYMMDD_HHmmSS
  *                      - Changed getDateFromString to return FALSE if
  *                          string is equal to NA
+** 17 Oct 2026: Rev 5.1
+**                      - getDateFromString uses strtok_r and the date string methods use
+**                        localtime_r so they can be called while log folders are read in on threads
+**                      - created parseTimestamp method, it reads the "HH:MM:SS MM/DD/YY" timestamp
+**                        without strtok or changing the string and only calls mktime() when the
+**                        date changes, getDateFromString calls it
+**                      - a TimeList holds its times in an array instead of a linked list of
+**                        TimeElements, with the location of each time as an id into the
+**                        locations of the list. Times are added to the end or placed with a
+**                        binary search. created insertTime, getTime and getTimeLocation
+**                        methods in place of insert, Remove and removeAndDestroy, which were
+**                        not called. Removed the
+**                        RemoveDupTime method and the location and next of a TimeElement, which
+**                        were left over from the linked list
+**                      - created TimeBuckets, a ring of counts of incidents in buckets of time for
+**                        thresholds checked on buckets instead of on every time
 */
 
-// form a time_t object from the string representing the date that is 
-// read in from the log files.
-// read in from the log files.
+// The epoch of midnight of the last date parsed by parseTimestamp(). Each
+// thread keeps its own so log folders can be read in on threads.
+static __thread struct DateCache dateCache = { -1, -1, -1, 0, FALSE };
+
+// the value of the two digit number at the start of a string
+//	s	- The string holding the digits
+//	return	- The number
+static int twoDigits(const char* s) {
+	return (s[0] - '0')*10 + (s[1] - '0');
+}
+
+// check that a string starts with a timestamp in exactly the
+// "HH:MM:SS MM/DD/YY" format of the CSS log files
+//	s	- The string to check
+//	return	- TRUE if it does, FALSE otherwise
+static BOOL isFixedTimestamp(const char* s) {
+	static const char format[] = "00:00:00 00/00/00";
+	int i;
+	for(i = 0; format[i] != '\0'; i++) {
+		if(format[i] == '0' ? !isdigit((unsigned char)s[i]) : s[i] != format[i]) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+// the epoch of a time on a date, found from the cached midnight of that date
+// when it is the same as the last date parsed. mktime() is only called when the
+// date changes, or for every time on a date that changes to or from DST.
+//	date	- The date and time, with tm_isdst set to -1
+//	return	- The epoch of the date and time
+static time_t epochOfDate(struct tm* date) {
+	if(date->tm_year != dateCache.year || date->tm_mon != dateCache.month || date->tm_mday != dateCache.day) {
+		struct tm midnight = *date;
+		midnight.tm_hour = 0;
+		midnight.tm_min = 0;
+		midnight.tm_sec = 0;
+		midnight.tm_isdst = -1;
+		dateCache.midnight = mktime(&midnight);
+		// a day that changes to or from DST does not end 86399 seconds after it starts
+		struct tm lastSecond = *date;
+		lastSecond.tm_hour = 23;
+		lastSecond.tm_min = 59;
+		lastSecond.tm_sec = 59;
+		lastSecond.tm_isdst = -1;
+		dateCache.uniform = (mktime(&lastSecond) == dateCache.midnight + SECONDS_IN_DAY - 1);
+		dateCache.year = date->tm_year;
+		dateCache.month = date->tm_mon;
+		dateCache.day = date->tm_mday;
+	}
+	if(dateCache.uniform && date->tm_hour < 24 && date->tm_min < 60 && date->tm_sec < 60) {
+		return dateCache.midnight + date->tm_hour*3600 + date->tm_min*60 + date->tm_sec;
+	}
+	return mktime(date);
+}
+
+// the value of the next number in a string split by a separator, like atoi()
+// of the next token from strtok()
+//	s	- A pointer to the string, moved past the number and its separator
+//	end	- The end of the string
+//	sep	- The char the numbers are split by
+//	return	- The number, 0 if there is none
+static int nextField(const char** s, const char* end, char sep) {
+	while(*s < end && **s == sep) {
+		(*s)++;
+	}
+	char field[9];
+	int i = 0;
+	while(*s < end && **s != sep && i < 8) {
+		field[i++] = **s;
+		(*s)++;
+	}
+	field[i] = '\0';
+	return atoi(field);
+}
+
+// form a time_t object from the timestamp at the start of a string, without
+// changing the string. Timestamps in the usual "HH:MM:SS MM/DD/YY" format are
+// read directly, anything else is split up the way getDateFromString() always has.
 //	s	- The string to find the time from
 //	tt	- A pointer to the time_t variable that will hold the parsed time
-//	return	- A BOOL indicating whether or not a time was parsed 
-BOOL getDateFromString(char* s, time_t* tt)  {	
-	// Overheard
-        if (strcmp(s, "NA") == 0) {
-            return FALSE;
-        }
-	if (s == NULL || strlen(s) < 8)
-	{
+//	length	- A pointer to an int that will hold the number of chars the timestamp
+//		  and the separator after it take up, may be NULL
+//	return	- A BOOL indicating whether or not a time was parsed
+BOOL parseTimestamp(const char* s, time_t* tt, int* length) {
+	if (s == NULL || strcmp(s, "NA") == 0) {
+		return FALSE;
+	}
+	int len = strlen(s);
+	if (len < 8) {
 		return FALSE;
 	}
 	struct tm newDate;
 	newDate.tm_isdst = -1;
-	char tmp[9];
+	int used;
 
-	// Get time portion
-	strncpy(tmp, s, 8);
-	tmp[8] = '\0';
-	newDate.tm_hour = atoi(strtok(tmp, ":"));
-	newDate.tm_min = atoi(strtok(NULL, ":"));
-	newDate.tm_sec = atoi(strtok(NULL, ":"));
-	removeFirstChars(s, 9);
-	
-	// Get date portion
-	strncpy(tmp, s, 8);
-	tmp[8] = '\0';
-	newDate.tm_mon = atoi(strtok(tmp, "/")) - 1; // months begin at zero
-	newDate.tm_mday = atoi(strtok(NULL, "/"));
-	newDate.tm_year = atoi(strtok(NULL, "/")) + 2000 - 1900;
-	removeFirstChars(s, 8);
-  
-	if((s[0]==' ') || (s[0]=='|') || (s[0]==',')) {
-		removeFirstChars(s, 1);
+	if(isFixedTimestamp(s)) {
+		newDate.tm_hour = twoDigits(s);
+		newDate.tm_min = twoDigits(s + 3);
+		newDate.tm_sec = twoDigits(s + 6);
+		newDate.tm_mon = twoDigits(s + 9) - 1; // months begin at zero
+		newDate.tm_mday = twoDigits(s + 12);
+		newDate.tm_year = twoDigits(s + 15) + 2000 - 1900;
+		used = TIMESTAMP_LENGTH;
 	}
-	
+	else {
+		// Get time portion from the first 8 chars
+		const char* field = s;
+		newDate.tm_hour = nextField(&field, s + 8, ':');
+		newDate.tm_min = nextField(&field, s + 8, ':');
+		newDate.tm_sec = nextField(&field, s + 8, ':');
+		used = len >= 9 ? 9 : 0;
+
+		// Get date portion from the next 8 chars
+		int dateLength = len - used < 8 ? len - used : 8;
+		field = s + used;
+		newDate.tm_mon = nextField(&field, s + used + dateLength, '/') - 1; // months begin at zero
+		newDate.tm_mday = nextField(&field, s + used + dateLength, '/');
+		newDate.tm_year = nextField(&field, s + used + dateLength, '/') + 2000 - 1900;
+		if(len - used >= 8) {
+			used += 8;
+		}
+	}
+
+	if((s[used]==' ') || (s[used]=='|') || (s[used]==',')) {
+		used++;
+	}
+	if(length != NULL) {
+		*length = used;
+	}
+
 	// create TimeElement object
-	*tt = mktime(&newDate);
-	
+	*tt = epochOfDate(&newDate);
+
+	return TRUE;
+}
+
+// form a time_t object from the string representing the date that is 
+// read in from the log files. The timestamp is removed from the start of
+// the string.
+//	s	- The string to find the time from
+//	tt	- A pointer to the time_t variable that will hold the parsed time
+//	return	- A BOOL indicating whether or not a time was parsed 
+BOOL getDateFromString(char* s, time_t* tt)  {	
+	int length;
+	if(!parseTimestamp(s, tt, &length)) {
+		return FALSE;
+	}
+	removeFirstChars(s, length);
 	return TRUE;
 }
 
@@ -71,136 +194,168 @@ BOOL getDateFromString(char* s, time_t* tt)  {
 //	tl	- The Time List to be initalized
 //	return	- Void
 void createTimeList(struct TimeList* tl) {
-	tl->head = NULL;
-	tl->tail = tl->head;
+	tl->times = NULL;
+	tl->locationIds = NULL;
 	tl->count = 0;
+	tl->capacity = 0;
+	tl->locationNames = NULL;
+	tl->locationCount = 0;
+}
+
+// find the id of a location in the list, adding it to locationNames if it is
+// not already there. A list holds the few locations of one record, so they are
+// searched in order.
+//	tl		- The Time List
+//	location	- The location, NULL or empty for none
+//	return		- The location id, NO_LOCATION if there is no location
+static int findTimeLocationId(struct TimeList* tl, const char* location) {
+	if(location == NULL || *location == '\0') {
+		return NO_LOCATION;
+	}
+	int i;
+	for(i = 0; i < tl->locationCount; i++) {
+		if(strcmp(tl->locationNames[i], location) == 0) {
+			return i;
+		}
+	}
+	tl->locationNames = realloc(tl->locationNames, (tl->locationCount + 1)*sizeof(char*));
+	tl->locationNames[tl->locationCount] = (char*)calloc(strlen(location) + 1, sizeof(char));
+	strcpy(tl->locationNames[tl->locationCount], location);
+	tl->locationCount++;
+	return tl->locationCount - 1;
+}
+
+// make room for one more time at the end of the arrays, the arrays are doubled
+// when they are full
+//	tl	- The Time List
+//	return	- Void
+static void reserveTime(struct TimeList* tl) {
+	if(tl->count < tl->capacity) {
+		return;
+	}
+	tl->capacity = tl->capacity == 0 ? TIME_LIST_MIN_CAPACITY : tl->capacity*2;
+	tl->times = realloc(tl->times, tl->capacity*sizeof(time_t));
+	if(tl->locationIds != NULL) {
+		tl->locationIds = realloc(tl->locationIds, tl->capacity*sizeof(int));
+	}
 }
 
 // In order for readInFile methods and methods that check Threshold Conditions
 // to work the list must be ordered oldest to newest. The method will insert in 
-// order.
-// Other linked-linked in other files will not share this property, they will
-// be standard queues.
-//	tl	- The Time List to have the new TimeElement added into
-//	te	- The Time Element to be added
-//	return	- Void
-void insert(struct TimeList* tl, struct TimeElement* te) {
-    te->next = NULL; // just to be sure, avoid conflating lists.
-    if(tl->head == NULL) { // blank list
-		tl->head = te;
-		tl->tail = tl->head;
-		tl->tail->next = NULL;
+// order. Times are nearly always newer than the last one and are added to the
+// end, any other time is placed with a binary search and the newer times are
+// moved along. A time equal to the oldest goes before it, otherwise a time
+// equal to the newest goes after it.
+//	tl		- The Time List to have the new time added into
+//	timeObj		- The time to be added
+//	location	- The location of the time, NULL or empty if it has none
+//	return		- Void
+void insertTime(struct TimeList* tl, time_t timeObj, const char* location) {
+	int locationId = findTimeLocationId(tl, location);
+	int position;
+	if(tl->count == 0) { // blank list
+		position = 0;
 	}
-	else {
-		if(tl->head->timeObj >= te->timeObj ) { // insert at beginning
-			te->next = tl->head;
-			tl->head = te;
-		}
-		else if(tl->tail->timeObj <= te->timeObj) { // insert at the end
-			tl->tail->next = te;
-			tl->tail = te;
-			tl->tail->next = NULL;
-		}
-		else { // cycle through list and find proper location
-			struct TimeElement* tmp = tl->head;
-			while(tmp->next->timeObj < te->timeObj) {
-				tmp = tmp->next;
+	else if(tl->times[0] >= timeObj) { // insert at beginning
+		position = 0;
+	}
+	else if(tl->times[tl->count - 1] <= timeObj) { // insert at the end
+		position = tl->count;
+	}
+	else { // binary search for the first time that is not older
+		int low = 0;
+		int high = tl->count - 1;
+		while(low < high) {
+			int mid = (low + high)/2;
+			if(tl->times[mid] < timeObj) {
+				low = mid + 1;
+			}
+			else {
+				high = mid;
 			}
-			// tmp is now smaller than te,
-			// tmp->next is larger.
-			// insert te
-			te->next = tmp->next;
-			tmp->next = te;
 		}
+		position = low;
+	}
+
+	if(locationId != NO_LOCATION && tl->locationIds == NULL) {
+		tl->locationIds = malloc((tl->capacity > 0 ? tl->capacity : TIME_LIST_MIN_CAPACITY)*sizeof(int));
+		int i;
+		for(i = 0; i < tl->count; i++) {
+			tl->locationIds[i] = NO_LOCATION;
+		}
+	}
+
+	reserveTime(tl);
+	memmove(tl->times + position + 1, tl->times + position, (tl->count - position)*sizeof(time_t));
+	if(tl->locationIds != NULL) {
+		memmove(tl->locationIds + position + 1, tl->locationIds + position, (tl->count - position)*sizeof(int));
+	}
+	tl->times[position] = timeObj;
+	if(tl->locationIds != NULL) {
+		tl->locationIds[position] = locationId;
 	}
 	tl->count++;
 }
 
-// This method will print out TimeList as comma separatevoid RemoveDupTime(struct TimeList* tl, t_time time);d list.
+// the time at a position of the list
+//	tl	- The Time List
+//	i	- The position, 0 is the oldest time
+//	return	- The time
+time_t getTime(struct TimeList* tl, int i) {
+	return tl->times[i];
+}
+
+// the location of the time at a position of the list
+//	tl	- The Time List
+//	i	- The position, 0 is the oldest time
+//	return	- The location, "" if the time has none
+const char* getTimeLocation(struct TimeList* tl, int i) {
+	if(tl->locationIds == NULL || tl->locationIds[i] == NO_LOCATION) {
+		return "";
+	}
+	return tl->locationNames[tl->locationIds[i]];
+}
+
+// This method will print out TimeList as comma separated list.
 // This is used to write out database file.
 // see "printDatabaseToFile"
 //	stream	- The file in which the Time List will be written
 //	tl	- The Time List to be written
 //	return	- Void
 void printTimeList(FILE* stream, struct TimeList* tl) {
-	struct TimeElement* tmp = tl->head;
-	if(tl->count > 0) {
-                char *s; //tmp var for getStringFromDate
-		while(tmp->next != NULL) {
-                    fprintf(stream, "%s,", s = getStringFromDate(tmp->timeObj));
-                    free(s);
-                    tmp = tmp->next;
-		}
-		fprintf(stream, "%s\n", s = getStringFromDate(tmp->timeObj));
-                free(s);
-        }
+	int i;
+	char *s; //tmp var for getStringFromDate
+	for(i = 0; i < tl->count; i++) {
+		fprintf(stream, "%s%s", s = getStringFromDate(getTime(tl, i)), i < tl->count - 1 ? "," : "\n");
+		free(s);
+	}
+	// a record kept for its TimeBuckets can have no times
+	if(tl->count == 0) {
+		fprintf(stream, "\n");
+	}
 }
 
-// This method will print out TimeList as comma separatevoid RemoveDupTime(struct TimeList* tl, t_time time);d list.
+// This method will print out TimeList as comma separated list of times and
+// their locations.
 // This is used to write out database file.
 // see "printDatabaseToFile"
 //	stream	- The file in which the Time List will be written
 //	tl	- The Time List to be written
 //	return	- Void
 void printOnboardTimeList(FILE* stream, struct TimeList* tl) {
-	struct TimeElement* tmp = tl->head;
-	if(tl->count > 0) {
-                char *s; //tmp var for getStringFromDate
-		while(tmp->next != NULL) {
-                    fprintf(stream, "%s|%s,", s = getStringFromDate(tmp->timeObj), tmp->location);
-                    free(s);
-                    tmp = tmp->next;
-		}
-		fprintf(stream, "%s|%s\n", s = getStringFromDate(tmp->timeObj), tmp->location);
-                free(s);
-        }
-}
-
-// remove element from the head of the list
-// returns a pointer to the removed element
-//	tl	- The Time List to have it's head removed
-//	te	- (see all previous remove functions)
-//	return	- Void
-void Remove(struct TimeList* tl, struct TimeElement* te) {
-	te = tl->head;
-	if(tl->count > 1) {
-		tl->head = tl->head->next;
-		tl->count--;
-		te->next = NULL; // ensure complete sever from the list
+	int i;
+	char *s; //tmp var for getStringFromDate
+	for(i = 0; i < tl->count; i++) {
+		fprintf(stream, "%s|%s%s", s = getStringFromDate(getTime(tl, i)), getTimeLocation(tl, i),
+		  i < tl->count - 1 ? "," : "\n");
+		free(s);
 	}
-	else if(tl->count == 1) {
-		tl->head = NULL;
-		tl->tail = tl->head;
-		tl->count = 0;
-		te->next = NULL; // ensure complete sever from the list
-	}
-	else { // count is 0
-		tl->count=0; // just a precaution
+	// a record kept for its TimeBuckets can have no times
+	if(tl->count == 0) {
+		fprintf(stream, "\n");
 	}
 }
 
-// removes a TimeElement from the list at the head and then destroys it
-//	tl	- The Time List to have it's head removed and the head's allocated memory freed
-//	return	- Void
-void removeAndDestroy(struct TimeList* tl) {
-	struct TimeElement* te = tl->head;
-	if(tl->count > 1) {
-		tl->head = tl->head->next;
-		tl->count--;
-		te->next = NULL; // ensure complete sever from the list
-	}
-	else if(tl->count == 1) {
-		tl->head = NULL;
-		tl->tail = tl->head;
-		tl->count = 0;
-		te->next = NULL; // ensure complete sever from the list
-	}
-	else { // count is 0
-		tl->count=0; // just a precaution
-	}
-  free(te->location);
-	free(te);
-}
 //returns the count of a Time List
 //	tl	- The Time List who's count will be returned
 //	return	- The count of the Time List
@@ -208,18 +363,185 @@ int getCount(struct TimeList* tl) {
 	return tl->count;
 }
 
-// Repeated calls removeAndDestroy on the list until the list is
-// empty, then destroy the TimeList object
+// free the arrays of the list and then destroy the TimeList object
 //	tl	- The Time List which will be deleted
 //	return	- Void
 void destroyTimeList(struct TimeList* tl) {
-	while(tl->count > 0)
-	{
-		removeAndDestroy(tl);
+	int i;
+	for(i = 0; i < tl->locationCount; i++) {
+		free(tl->locationNames[i]);
 	}
+	free(tl->locationNames);
+	free(tl->locationIds);
+	free(tl->times);
 	free(tl);
 }
 
+// create TimeBuckets with enough buckets to cover a number of minutes, every
+// bucket is empty
+//	bucketMinutes	- The number of minutes each bucket holds
+//	spanMinutes	- The number of minutes the buckets cover together
+//	return		- The TimeBuckets
+struct TimeBuckets* createTimeBuckets(int bucketMinutes, int spanMinutes) {
+	struct TimeBuckets* tb = malloc(sizeof(struct TimeBuckets));
+	tb->bucketMinutes = bucketMinutes > 0 ? bucketMinutes : 1;
+	tb->bucketCount = (spanMinutes + tb->bucketMinutes - 1)/tb->bucketMinutes;
+	if(tb->bucketCount < 1) {
+		tb->bucketCount = 1;
+	}
+	tb->firstBucket = 0;
+	tb->first = 0;
+	tb->counts = calloc(tb->bucketCount, sizeof(int));
+	tb->total = 0;
+	return tb;
+}
+
+// empty every bucket
+//	tb	- The TimeBuckets
+//	return	- Void
+static void clearTimeBuckets(struct TimeBuckets* tb) {
+	memset(tb->counts, 0, tb->bucketCount*sizeof(int));
+	tb->first = 0;
+	tb->total = 0;
+}
+
+// the number of the bucket a time is in
+//	tb	- The TimeBuckets
+//	timeObj	- The time
+//	return	- The bucket number
+static long getBucketNumber(struct TimeBuckets* tb, time_t timeObj) {
+	return (long)(timeObj/(tb->bucketMinutes*60));
+}
+
+// move the buckets along so the bucket of a time is the newest one. The
+// buckets that are moved past are emptied and reused, nothing is done if the
+// bucket of the time is not newer than the newest bucket.
+//	tb	- The TimeBuckets
+//	timeObj	- The time
+//	return	- Void
+void advanceTimeBuckets(struct TimeBuckets* tb, time_t timeObj) {
+	long newest = tb->firstBucket + tb->bucketCount - 1;
+	long steps = getBucketNumber(tb, timeObj) - newest;
+	if(steps <= 0) {
+		return;
+	}
+	if(steps >= tb->bucketCount) { // every bucket is moved past
+		clearTimeBuckets(tb);
+	}
+	else {
+		long i;
+		for(i = 0; i < steps; i++) {
+			tb->total -= tb->counts[tb->first];
+			tb->counts[tb->first] = 0;
+			tb->first = (tb->first + 1) % tb->bucketCount;
+		}
+	}
+	tb->firstBucket += steps;
+}
+
+// add to the count of a bucket by its number, nothing is done if it is older
+// than the oldest bucket
+//	tb	- The TimeBuckets
+//	bucket	- The number of the bucket
+//	count	- The number of incidents to add
+//	return	- Void
+static void addToBucket(struct TimeBuckets* tb, long bucket, int count) {
+	if(bucket < tb->firstBucket || bucket >= tb->firstBucket + tb->bucketCount) {
+		return;
+	}
+	tb->counts[(tb->first + (bucket - tb->firstBucket)) % tb->bucketCount] += count;
+	tb->total += count;
+}
+
+// count an incident in the bucket of its time, the buckets are moved along
+// first if it is newer than the newest bucket
+//	tb	- The TimeBuckets
+//	timeObj	- The time of the incident
+//	return	- Void
+void addTimeToBuckets(struct TimeBuckets* tb, time_t timeObj) {
+	advanceTimeBuckets(tb, timeObj);
+	addToBucket(tb, getBucketNumber(tb, timeObj), 1);
+}
+
+// the number of incidents in a bucket
+//	tb	- The TimeBuckets
+//	i	- The position of the bucket, 0 is the oldest
+//	return	- The number of incidents
+int getBucketCount(struct TimeBuckets* tb, int i) {
+	return tb->counts[(tb->first + i) % tb->bucketCount];
+}
+
+// the time a bucket starts at
+//	tb	- The TimeBuckets
+//	i	- The position of the bucket, 0 is the oldest
+//	return	- The time
+time_t getBucketStart(struct TimeBuckets* tb, int i) {
+	return (time_t)(tb->firstBucket + i)*tb->bucketMinutes*60;
+}
+
+// write out the buckets as "<bucketMinutes>-<bucket>-<count>,<count>,..." where
+// bucket is the number of the first bucket written. The empty buckets at
+// either end are left out.
+//	stream	- The file the buckets will be written to
+//	tb	- The TimeBuckets
+//	return	- Void
+void printTimeBuckets(FILE* stream, struct TimeBuckets* tb) {
+	int first = 0;
+	int last = tb->bucketCount - 1;
+	while(last >= 0 && getBucketCount(tb, last) == 0) {
+		last--;
+	}
+	while(first < last && getBucketCount(tb, first) == 0) {
+		first++;
+	}
+	fprintf(stream, "%d-%ld-", tb->bucketMinutes, tb->firstBucket + first);
+	int i;
+	for(i = first; i <= last; i++) {
+		fprintf(stream, i < last ? "%d," : "%d", getBucketCount(tb, i));
+	}
+}
+
+// read in buckets written by printTimeBuckets and add them to the counts of
+// the buckets they are in. The buckets are moved along to the newest one read.
+//	tb	- The TimeBuckets, created with the size of bucket that is expected
+//	s	- The string to read them from
+//	return	- TRUE if they were read in, FALSE if the string could not be read
+//		  or holds buckets of another size, the buckets are left empty
+BOOL readTimeBuckets(struct TimeBuckets* tb, const char* s) {
+	char* end;
+	int bucketMinutes = (int)strtol(s, &end, 10);
+	if(*end != '-' || bucketMinutes != tb->bucketMinutes) {
+		return FALSE;
+	}
+	long bucket = strtol(end + 1, &end, 10);
+	if(*end != '-') {
+		return FALSE;
+	}
+	s = end + 1;
+	while(*s != '\0') {
+		int count = (int)strtol(s, &end, 10);
+		if(end == s) {
+			clearTimeBuckets(tb);
+			return FALSE;
+		}
+		if(count > 0) {
+			advanceTimeBuckets(tb, (time_t)bucket*tb->bucketMinutes*60);
+			addToBucket(tb, bucket, count);
+		}
+		bucket++;
+		s = *end == ',' ? end + 1 : end;
+	}
+	return TRUE;
+}
+
+// free TimeBuckets
+//	tb	- The TimeBuckets to be freed
+//	return	- Void
+void destroyTimeBuckets(struct TimeBuckets* tb) {
+	free(tb->counts);
+	free(tb);
+}
+
 // Takes a time_t object and converts it into a tm struct,
 // values are then formatted into a CSS friendly string format
 // returned format is "HH:mm:SS MM/DD/YY" 
@@ -228,7 +550,8 @@ void destroyTimeList(struct TimeList* tl) {
 char* getStringFromDate(time_t timeObj) {
   char* s = (char*)calloc(DATE_STRING_LENGTH, sizeof(char));
 	strcpy(s, "");
-	struct tm *timeStructure	= localtime(&timeObj);
+	struct tm timeBuffer;
+	struct tm *timeStructure	= localtime_r(&timeObj, &timeBuffer);
 	char* tmp = (char*)calloc(6, sizeof(char));
 	
   // Hour
@@ -281,7 +604,8 @@ char* getStringFromDate(time_t timeObj) {
 char* getISOStringFromDate(time_t timeObj) {
   char* s = (char*)calloc(ISODATE_STRING_LENGTH, sizeof(char));
 	strcpy(s, "");
-	struct tm *timeStructure	= localtime(&timeObj);
+	struct tm timeBuffer;
+	struct tm *timeStructure	= localtime_r(&timeObj, &timeBuffer);
 	char* tmp = (char*)calloc(6, sizeof(char));
 	
 
@@ -340,7 +664,8 @@ char* getISOStringFromDate(time_t timeObj) {
 char* getFilenameFromDate(time_t timeObj) {
 	char* s = (char*)calloc(DATE_STRING_LENGTH, sizeof(char));
 	strcpy(s, "");
-	struct tm *timeStructure	= localtime(&timeObj);
+	struct tm timeBuffer;
+	struct tm *timeStructure	= localtime_r(&timeObj, &timeBuffer);
 	char* tmp = (char*)calloc(6, sizeof(char));
 	
 	sprintf(tmp, "%d", timeStructure->tm_year + 1900);
@@ -422,8 +747,9 @@ char* getSlashlessDatestampFromDate(time_t timeObj) {
         char* s = (char*)calloc(STRING_LENGTH,sizeof(char));
 	strcpy(s, "");
         
+	struct tm timeBuffer;
 	struct tm *timeStructure;
-        timeStructure  = localtime(&timeObj);
+        timeStructure  = localtime_r(&timeObj, &timeBuffer);
 	char* tmp = (char*)calloc(6, sizeof(char));
 
         
@@ -471,40 +797,3 @@ char* getSlashlessDatestampFromDate(time_t timeObj) {
         free(tmp);
 	return s;
 }
-//A function that will go through a time list and remove any duplicate times as specficed by time
-//	timeList	- The Time List from which duplicate times will be removed
-//	time		- The time to be searched for
-//	return		- Void
-void RemoveDupTime(struct TimeList* timeList, time_t time)
-{
-	int count = 0;
-	struct TimeElement* timeElement = timeList->head;
-	struct TimeElement* prevElement = timeList->head;
-	while(timeElement != NULL)
-	{	
-		//if they are the same time
-		if(timeElement->timeObj == time)
-		{
-			//if count is not 0, remove the duplicate time
-			if(count != 0)
-			{
-				//sever the next from the dup
-				struct TimeElement* tmp = timeElement->next;
-				timeElement->next = NULL;
-				//move to next element
-				timeElement = tmp;
-				//point previous element to the new next
-				prevElement->next = timeElement;
-			}
-			count++;
-		}
-		else
-		{
-			//move prev element to current element, and move to next element
-			prevElement = timeElement;
-			timeElement = timeElement->next;
-		}
-	}
-}
-
-
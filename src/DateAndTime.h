@@ -8,6 +8,10 @@
   // "YYYY-MM-DDTHH:mm:SSZ"
 #define FILTER_TIMES "filterTimes" // name of the file which will contain the
   // non-revenue hours
+#define TIMESTAMP_LENGTH 17 // Length of a "HH:MM:SS MM/DD/YY" timestamp
+#define SECONDS_IN_DAY 86400 // seconds in a day without a change to or from DST
+#define TIME_LIST_MIN_CAPACITY 8 // the number of times a TimeList first has room for
+#define NO_LOCATION -1 // the location id of a time in a TimeList without a location
 
 /*
 ** Structures
@@ -15,22 +19,63 @@
 */  
   
 // timeObj will be the time that an incident occurs
-// next will be a pointer to the next TimeElement struct
 struct TimeElement	{
 	time_t timeObj;
-  char* location;
-	struct TimeElement* next;
 };
 
-// container for a linked list of TimeElement structs
+// the epoch of midnight of the last date that had a timestamp parsed
+
+// year, month and day are the date, as in a struct tm, -1 if none has been parsed
+// midnight is the epoch of the start of that date
+// uniform is TRUE if the date does not change to or from DST, so the epoch of
+  // any time on it is midnight plus the seconds since midnight
+struct DateCache {
+	int year;
+	int month;
+	int day;
+	time_t midnight;
+	BOOL uniform;
+};
 
-// head is the first element
-// tail is the last element
-// count is the number of elements
+// the times a DatabaseRecord or SummaryEmail occurred at, oldest to newest, held
+// in an array
+
+// times is the array of times
+// locationIds is the location of each time, an index into locationNames or
+  // NO_LOCATION, in the same order as times. NULL until a time with a location
+  // is inserted, only the times of onboard incidents have locations
+// count is the number of times
+// capacity is the number of times the arrays have room for
+// locationNames is the different locations of the times in the list
+// locationCount is the number of locationNames
 struct TimeList	{
-	struct TimeElement* head;
-	struct TimeElement* tail;
+	time_t* times;
+	int* locationIds;
 	int count;
+	int capacity;
+	char** locationNames;
+	int locationCount;
+};
+
+// the number of incidents in each bucket of time of a fixed number of minutes,
+// for thresholds over long periods that would need too many times to be kept.
+// A ring of counters, the buckets are numbered from the epoch and the oldest
+// bucket is dropped when a newer one is needed.
+
+// bucketMinutes is the number of minutes each bucket holds
+// bucketCount is the number of buckets
+// firstBucket is the number of the oldest bucket, the epoch divided by the
+  // seconds in a bucket
+// first is the index in counts of the oldest bucket
+// counts is the number of incidents in each bucket
+// total is the number of incidents in every bucket
+struct TimeBuckets {
+	int bucketMinutes;
+	int bucketCount;
+	long firstBucket;
+	int first;
+	int* counts;
+	int total;
 };
 
 /*
@@ -43,36 +88,57 @@ struct TimeList	{
 // read in from the log files.
 BOOL getDateFromString(char* s, time_t* tt );
 
+// form a time_t object from the timestamp at the start of a string without
+// changing the string, length is set to the number of chars it took up
+BOOL parseTimestamp(const char* s, time_t* tt, int* length);
+
 // Initialize variables for TimeList
 void createTimeList(struct TimeList* tl);
 
 // In order for readInFile methods and methods that check Threshold Conditions
 // to work the list most be order oldest to newest. The method will insert in 
 // order.
-// Other linked-linked in other files will not share this proper, they will
-// be standard queues.
-void insert(struct TimeList* tl, struct TimeElement* te);
+void insertTime(struct TimeList* tl, time_t timeObj, const char* location);
+
+// the time at a position of the list, 0 is the oldest
+time_t getTime(struct TimeList* tl, int i);
+
+// the location of the time at a position of the list, "" if it has none
+const char* getTimeLocation(struct TimeList* tl, int i);
 
 // This method will print out TimeList as comma separated list.
 // This is used to write out database file.
 // see "printDatabaseToFile"
 void printTimeList(FILE* stream, struct TimeList* tl);
 
-// remove element from the head of the list
-// returns a pointer to the removed element
-void Remove(struct TimeList* tl, struct TimeElement* te);
+int getCount(struct TimeList* tl);
+
+// free the arrays of the list and then destroy the TimeList object
+void destroyTimeList(struct TimeList* tl);
 
-// removes all but one of the timeElement structs with time time.
-void RemoveDupTime(struct TimeList* timeList, time_t time);
+// create TimeBuckets with enough buckets of 'bucketMinutes' to cover 'spanMinutes'
+struct TimeBuckets* createTimeBuckets(int bucketMinutes, int spanMinutes);
 
-// removes a TimeElement from the list at the head and then destroys it
-void removeAndDestroy(struct TimeList* tl);
+// move the buckets along so the bucket of a time is the newest one, if it is newer
+void advanceTimeBuckets(struct TimeBuckets* tb, time_t timeObj);
 
-int getCount(struct TimeList* tl);
+// count an incident at a time in its bucket, it is not counted if it is older than the buckets
+void addTimeToBuckets(struct TimeBuckets* tb, time_t timeObj);
 
-// Repeated calls removeAndDestroy on the list until the list is
-// empty, then destroy the TimeList object
-void destroyTimeList(struct TimeList* tl);
+// the number of incidents in a bucket, 0 is the oldest
+int getBucketCount(struct TimeBuckets* tb, int i);
+
+// the time a bucket starts at, 0 is the oldest
+time_t getBucketStart(struct TimeBuckets* tb, int i);
+
+// write out the buckets as "<bucketMinutes>-<firstBucket>-<count>,<count>,..."
+void printTimeBuckets(FILE* stream, struct TimeBuckets* tb);
+
+// read in buckets written by printTimeBuckets
+BOOL readTimeBuckets(struct TimeBuckets* tb, const char* s);
+
+// free TimeBuckets
+void destroyTimeBuckets(struct TimeBuckets* tb);
 
 // Takes a time_t object and converts it into a tm struct,
 // values are then formatted into a CSS friendly string format
@@ -98,7 +164,4 @@ BOOL getDateFromFileName(char* s, time_t* tt);
 // "HHmmSS_MMDDYY" 
 char* getSlashlessDatestampFromDate(time_t timeObj);
 
-//A function that will go through a time list and remove any duplicate times as specficed by time
-void RemoveDupTime(struct TimeList* timeList, time_t time);
-
 void printOnboardTimeList(FILE* stream, struct TimeList* tl);
@@ -18,6 +18,26 @@
 **                      - This file was created in release 1.1
 **                      - Many methods are copies of Incident.c methods
 **                      -
+** 17 Oct 2026: Rev 5.1
+**                      - created buildDisabledIncidentIndex, destroyDisabledIncidentIndex and
+**                        disabledIncidentIndexContains methods. The disabled incidents are
+**                        indexed by location with their windows sorted by start time and their
+**                        incident types held as a bitset. A disabled incident of type "ALL"
+**                        disables every type, as typeOfIncidentListContain() does
+**                      - readInDisabledIncidents2() sets location2 and data to NULL, they were
+**                        left uninitialized and copyDisabledIncident() copied from them
+**                      - a location of the temporary disabled incidents file can be a range,
+**                        ie; Finch..Eglinton, which disables every location on the line between
+**                        the two. readInDisabledIncidents2() splits it into location1 and location2,
+**                        changeStationNames() changes both and the DisabledIncidentIndex holds the
+**                        windows of each range by the ordinals of its ends along the line
+**                      - created disabledIncidentCoversLocation method
+**                      - changeStationNames() looks the conventional names up in the hash table of
+**                        the StationPairList and moves the disabled incidents into a new list
+**                        with their copies, it no longer adds to the list it is walking
+**                      - buildDisabledIncidentIndex() takes the IncidentTypeList and builds the type
+**                        bitset of each disabled incident from the type ids, "ALL" sets every bit.
+**                        disabledIncidentIndexContains() takes the type id of the incident
 **
 */
 
@@ -28,6 +48,8 @@ void createDisabledIncidentList(struct DisabledIncidentList* dil) {
 	dil->head = NULL;
 	dil->tail = dil->head;
 	dil->count = 0;
+	dil->index = NULL;
+	dil->lineTopology = NULL;
 }
 
 // Standard linked-list Queue style insert at the tail of the list
@@ -91,6 +113,8 @@ void removeAndDestroyDisabledIncident(struct DisabledIncidentList* dil) {
 		dil->count=0; // just a precaution
 	}
 	free(din->location1);
+	free(din->location2);
+	free(din->data);
 	free(din->other);
 	free(din);
 }
@@ -106,6 +130,10 @@ int getCountOfDisabledIncidentList(struct DisabledIncidentList* dil) {
 //	dil	- The Disabled Incident List to be destroyed
 //	return	- Void
 void destroyDisabledIncidentList(struct DisabledIncidentList* dil) {
+	// the index points at the strings of the disabled incidents
+	destroyDisabledIncidentIndex(dil->index);
+	dil->index = NULL;
+	destroyLineTopology(dil->lineTopology);
 	while(dil->count > 0) {
 		removeAndDestroyDisabledIncident(dil);
 	}
@@ -136,6 +164,9 @@ void printDisabledIncidentList(struct DisabledIncidentList* dil) {
 			// Left in in case problems reappear
 			printTypeOfIncidentList(tmp->typeOfIncidentList);
 			tmp->location1 != NULL ? printf("Loc:%s|", tmp->location1) : printf("Loc:NULL|");
+			if(tmp->location2 != NULL && tmp->location2[0] != '\0') {
+				printf("Loc2:%s|", tmp->location2);
+			}
 			tmp->data != NULL ? printf("Data:%s|", tmp->data) : printf("Data:NULL|");
 			printf("StartTime:%s|EndTime:%s|", getStringFromDate(tmp->duration->startTime->timeObj),getStringFromDate(tmp->duration->endTime->timeObj));
             printf("\n");
@@ -207,6 +238,8 @@ void readInDisabledIncidents2(struct DisabledIncidentList* dil) {
             din->duration->startTime = malloc(sizeof(struct TimeElement));
             din->duration->endTime = malloc(sizeof(struct TimeElement));
           din->other = NULL;
+          din->location2 = NULL;
+          din->data = NULL;
           din->location1 = (char*)calloc(STRING_LENGTH, sizeof(char));
         
 		// parse string 'tmp' and store sections in small strings.
@@ -214,6 +247,14 @@ void readInDisabledIncidents2(struct DisabledIncidentList* dil) {
         strcpy(din->location1, strtok(NULL, ";"));
         strcpy(dateStr1, strtok(NULL, ";"));
         strcpy(dateStr2, strtok(NULL, ";"));
+
+        // a range of locations, ie; Finch..Eglinton, is split into its two ends
+        char* separator = strstr(din->location1, LOCATION_RANGE_SEPARATOR);
+        if(separator != NULL) {
+          din->location2 = (char*)calloc(STRING_LENGTH, sizeof(char));
+          strcpy(din->location2, separator + strlen(LOCATION_RANGE_SEPARATOR));
+          *separator = '\0';
+        }
 		
 		// get date object from strings 
         getDateFromString(dateStr1, &(din->duration->startTime->timeObj));
@@ -284,48 +325,59 @@ void changeStationNames(struct DisabledIncidentList* dil) {
   readInConvToWBSSList(spl);
 
   printf("b\n");
+  // the disabled incidents are moved into a new list. Each one is followed
+  // by a copy for every other combination of WBSS names of its locations, so
+  // no incident is changed twice and the list is not added to while it is walked
+  struct DisabledIncidentList expanded;
+  createDisabledIncidentList(&expanded);
   struct DisabledIncident* din = dil->head;
-  BOOL preMatchFound = FALSE;
-  char* convName = (char*)calloc(STRING_LENGTH, sizeof(char));  
 
   // a while loop to cycle through all of the elements in the DisableIncidentsList
   while(din != NULL) {
-    // din->location1 may be change during the execution of this while loop, but its
-    // original value will still be needed. Because of this convName is used.	
-	strcpy(convName, din->location1);
-    preMatchFound = FALSE;
-    struct StationPair* sp = spl->head;
-	// a while loop to cycle through all of the elements in the StationPair list
-    while(sp != NULL) {
-      // if the 'conventional name' field of the StationPair matches the 
-      // name of the location for the disabled incident and this 
-	  // is the first time a match has beeb found, copy the
-      // proper wbss name into it
-      if(strcmp(sp->location1, convName)==0  && !preMatchFound) {
-        strcpy(din->location1, sp->location2);
-        preMatchFound = TRUE;
-      }
-      // if the 'conventional name' field of the StationPair matches the 
-      // name of the location for the disabled incident and another match 
-	  // has already been found then create a new incident and add it to the end
-	  // in this case the StationPairList has a single conventional name, that
-	  // incoporates two WBSS names:
-	  // e.g. (conventional name,WBSS name)
-	  // Bay Lower,Bay Lower BD
-	  // Bay Lower,Bay Lower YUS
-      else if(strcmp(sp->location1, convName)==0  && preMatchFound) {
-        struct DisabledIncident* new_din = malloc(sizeof(struct DisabledIncident));
-        copyDisabledIncident(new_din, din);
-        strcpy(new_din->location1, sp->location2);    
-        insertIntoDisabledIncidentList(dil, new_din);
-      }
-      sp=sp->next;
+    struct DisabledIncident* next = din->next;
+
+    // the WBSS names of each location, NULL if it has none and keeps its name.
+    // A conventional name can incorporate two WBSS names:
+    // e.g. (conventional name,WBSS name)
+    // Bay Lower,Bay Lower BD
+    // Bay Lower,Bay Lower YUS
+    struct StationPair* names1 = findStationPair(spl, din->location1, NULL);
+    struct StationPair* names2 = NULL;
+    if(din->location2 != NULL && din->location2[0] != '\0') {
+      names2 = findStationPair(spl, din->location2, NULL);
     }
-    din=din->next;
+
+    // din itself takes the first WBSS name of each location
+    BOOL firstCombination = TRUE;
+    struct StationPair* sp1 = names1;
+    do {
+      struct StationPair* sp2 = names2;
+      do {
+        struct DisabledIncident* target = din;
+        if(!firstCombination) {
+          target = malloc(sizeof(struct DisabledIncident));
+          copyDisabledIncident(target, din);
+        }
+        if(sp1 != NULL) {
+          strcpy(target->location1, sp1->location2);
+        }
+        if(sp2 != NULL) {
+          strcpy(target->location2, sp2->location2);
+        }
+        insertIntoDisabledIncidentList(&expanded, target);
+        firstCombination = FALSE;
+        sp2 = sp2 != NULL ? sp2->nextMatch : NULL;
+      } while(sp2 != NULL);
+      sp1 = sp1 != NULL ? sp1->nextMatch : NULL;
+    } while(sp1 != NULL);
+
+    din = next;
   }
+  dil->head = expanded.head;
+  dil->tail = expanded.tail;
+  dil->count = expanded.count;
   
   //clean things up
-  free(convName);
   destroyStationPairList(spl);
 }
 
@@ -379,3 +431,327 @@ void copyDisabledIncident(struct DisabledIncident* new_din, struct DisabledIncid
      tmp=tmp->next;
    }
 }
+
+// find the slot of a name in a hash table of names, either the slot holding it
+// or the empty slot it would go in
+//	table		- The hash table, each slot holds an index into names or NO_NAME
+//	tableSize	- The number of slots in the table, a power of two
+//	names		- The names the table holds
+//	name		- The name to find
+//	return		- The slot
+static int findNameSlot(int* table, int tableSize, char** names, const char* name) {
+  int slot = hashString(name) & (tableSize - 1);
+  while(table[slot] != NO_NAME && strcmp(names[table[slot]], name) != 0) {
+    slot = (slot + 1) & (tableSize - 1);
+  }
+  return slot;
+}
+
+// add a name to a hash table of names if it is not already in it
+//	table		- The hash table
+//	tableSize	- The number of slots in the table
+//	names		- The names the table holds, the name is added to the end
+//	count		- The number of names, increased if the name is added
+//	name		- The name to add
+//	return		- The index of the name in names
+static int addName(int* table, int tableSize, char** names, int* count, char* name) {
+  int slot = findNameSlot(table, tableSize, names, name);
+  if(table[slot] == NO_NAME) {
+    names[*count] = name;
+    table[slot] = *count;
+    (*count)++;
+  }
+  return table[slot];
+}
+
+// order DisabledWindows by start time, for qsort
+//	a	- The first DisabledWindow
+//	b	- The second DisabledWindow
+//	return	- Less than, equal to or greater than 0 as a starts before, with or after b
+static int compareDisabledWindows(const void* a, const void* b) {
+  time_t startA = ((const struct DisabledWindow*)a)->start;
+  time_t startB = ((const struct DisabledWindow*)b)->start;
+  return (startA > startB) - (startA < startB);
+}
+
+// check if a DisabledIncident disables a range of locations rather than one
+//	din	- The DisabledIncident
+//	return	- TRUE if location2 is set, FALSE otherwise
+static BOOL isLocationRange(struct DisabledIncident* din) {
+  return din->location2 != NULL && din->location2[0] != '\0';
+}
+
+// find the line and ordinals of the range of a DisabledIncident. A range whose
+// ends are not on the same line disables only location1, as before ranges
+// could be entered.
+//	dil		- The Disabled Incident List, holding the LineTopology
+//	din		- The DisabledIncident
+//	line		- Set to the line of the range, NO_STOP if it only disables location1
+//	firstOrdinal	- Set to the lower ordinal of the range
+//	lastOrdinal	- Set to the higher ordinal of the range
+//	return		- Void
+static void findRangeOfDisabledIncident(struct DisabledIncidentList* dil, struct DisabledIncident* din,
+  int* line, int* firstOrdinal, int* lastOrdinal) {
+  *line = NO_STOP;
+  *firstOrdinal = NO_STOP;
+  *lastOrdinal = NO_STOP;
+  if(!isLocationRange(din) || dil->lineTopology == NULL) {
+    return;
+  }
+  if(!resolveLineRange(dil->lineTopology, din->location1, din->location2, line, firstOrdinal, lastOrdinal)) {
+    *line = NO_STOP;
+  }
+}
+
+// Index a DisabledIncidentList by location. This must be done after
+// changeStationNames(), so every WBSS name a conventional name was changed to
+// has its own location in the index. Windows that ended before pruneBefore
+// cannot hold any incident that will be read in and are left out. The windows
+// of a range of locations are kept by line instead of by location, with the
+// ordinals of the ends of the range.
+//	dil			- The Disabled Incident List to index
+//	incidentTypeList	- The incident type list that gives the type ids
+//	pruneBefore		- The earliest time an incident that will be checked can have
+//	return			- Void
+void buildDisabledIncidentIndex(struct DisabledIncidentList* dil, struct IncidentTypeList* incidentTypeList,
+  time_t pruneBefore) {
+  destroyDisabledIncidentIndex(dil->index);
+  dil->index = NULL;
+
+  // count the windows that are kept and build the type bitset of each
+  int windowTotal = 0;
+  struct DisabledIncident* din = dil->head;
+  while(din != NULL) {
+    if(din->duration->endTime->timeObj >= pruneBefore) {
+      windowTotal++;
+      buildTypeOfIncidentBits(din->typeOfIncidentList, incidentTypeList);
+    }
+    din = din->next;
+  }
+
+  struct DisabledIncidentIndex* index = malloc(sizeof(struct DisabledIncidentIndex));
+  index->tableSize = 16;
+  while(index->tableSize < 2*windowTotal) {
+    index->tableSize *= 2;
+  }
+  index->locationCount = 0;
+  index->locationNames = malloc((windowTotal + 1)*sizeof(char*));
+  index->locationTable = malloc(index->tableSize*sizeof(int));
+  index->lineTopology = dil->lineTopology;
+  int lineCount = dil->lineTopology != NULL ? dil->lineTopology->lineCount : 0;
+  int i;
+  for(i = 0; i < index->tableSize; i++) {
+    index->locationTable[i] = NO_NAME;
+  }
+
+  // the range of each window that is kept, NO_STOP for a single location
+  int* rangeLine = malloc((windowTotal + 1)*sizeof(int));
+  int* rangeFirst = malloc((windowTotal + 1)*sizeof(int));
+  int* rangeLast = malloc((windowTotal + 1)*sizeof(int));
+  int rangeCount = 0;
+
+  // give every location a number
+  int windowNumber = 0;
+  din = dil->head;
+  while(din != NULL) {
+    if(din->duration->endTime->timeObj >= pruneBefore) {
+      findRangeOfDisabledIncident(dil, din, &rangeLine[windowNumber], &rangeFirst[windowNumber], &rangeLast[windowNumber]);
+      if(rangeLine[windowNumber] == NO_STOP) {
+        if(isLocationRange(din) && dil->lineTopology != NULL) {
+          printf("%s and %s are not on the same line, only %s will be disabled\n", din->location1, din->location2, din->location1);
+        }
+        addName(index->locationTable, index->tableSize, index->locationNames, &index->locationCount, din->location1);
+      }
+      else {
+        rangeCount++;
+      }
+      windowNumber++;
+    }
+    din = din->next;
+  }
+  index->typeWords = incidentTypeList->typeWords;
+  index->typeBits = calloc((windowTotal + 1)*index->typeWords, sizeof(unsigned long long));
+
+  // count the windows of each location and line so they can be allocated together
+  index->locations = calloc(index->locationCount + 1, sizeof(struct DisabledLocation));
+  index->lines = calloc(lineCount + 1, sizeof(struct DisabledLocation));
+  int* windowsAtLocation = calloc(index->locationCount + 1, sizeof(int));
+  int* windowsOnLine = calloc(lineCount + 1, sizeof(int));
+  windowNumber = 0;
+  din = dil->head;
+  while(din != NULL) {
+    if(din->duration->endTime->timeObj >= pruneBefore) {
+      if(rangeLine[windowNumber] == NO_STOP) {
+        int slot = findNameSlot(index->locationTable, index->tableSize, index->locationNames, din->location1);
+        windowsAtLocation[index->locationTable[slot]]++;
+      }
+      else {
+        windowsOnLine[rangeLine[windowNumber]]++;
+      }
+      windowNumber++;
+    }
+    din = din->next;
+  }
+  for(i = 0; i < index->locationCount; i++) {
+    index->locations[i].windows = malloc(windowsAtLocation[i]*sizeof(struct DisabledWindow));
+    index->locations[i].windowCount = 0;
+  }
+  for(i = 0; i < lineCount; i++) {
+    index->lines[i].windows = malloc(windowsOnLine[i]*sizeof(struct DisabledWindow));
+    index->lines[i].windowCount = 0;
+  }
+  free(windowsAtLocation);
+  free(windowsOnLine);
+
+  // fill in the windows
+  windowNumber = 0;
+  din = dil->head;
+  while(din != NULL) {
+    if(din->duration->endTime->timeObj >= pruneBefore) {
+      struct DisabledLocation* location;
+      if(rangeLine[windowNumber] == NO_STOP) {
+        int slot = findNameSlot(index->locationTable, index->tableSize, index->locationNames, din->location1);
+        location = &index->locations[index->locationTable[slot]];
+      }
+      else {
+        location = &index->lines[rangeLine[windowNumber]];
+      }
+      struct DisabledWindow* window = &location->windows[location->windowCount++];
+      window->start = din->duration->startTime->timeObj;
+      window->end = din->duration->endTime->timeObj;
+      window->types = index->typeBits + windowNumber*index->typeWords;
+      window->firstOrdinal = rangeFirst[windowNumber];
+      window->lastOrdinal = rangeLast[windowNumber];
+      memcpy(window->types, din->typeOfIncidentList->typeBits, index->typeWords*sizeof(unsigned long long));
+      windowNumber++;
+    }
+    din = din->next;
+  }
+  free(rangeLine);
+  free(rangeFirst);
+  free(rangeLast);
+
+  // sort the windows of each location and line and find the latest end up to each one
+  for(i = 0; i < index->locationCount + lineCount; i++) {
+    struct DisabledLocation* location = i < index->locationCount ? &index->locations[i] : &index->lines[i - index->locationCount];
+    qsort(location->windows, location->windowCount, sizeof(struct DisabledWindow), compareDisabledWindows);
+    int w;
+    for(w = 0; w < location->windowCount; w++) {
+      location->windows[w].maxEnd = location->windows[w].end;
+      if(w > 0 && location->windows[w - 1].maxEnd > location->windows[w].maxEnd) {
+        location->windows[w].maxEnd = location->windows[w - 1].maxEnd;
+      }
+    }
+  }
+
+  printf("Disabled incident index: %d of %d windows kept at %d locations and %d ranges\n", windowTotal, dil->count, index->locationCount, rangeCount);
+  dil->index = index;
+}
+
+// free a DisabledIncidentIndex, the names it holds belong to the disabled incidents
+//	index	- The DisabledIncidentIndex to free
+//	return	- Void
+void destroyDisabledIncidentIndex(struct DisabledIncidentIndex* index) {
+  if(index == NULL) {
+    return;
+  }
+  int i;
+  for(i = 0; i < index->locationCount; i++) {
+    free(index->locations[i].windows);
+  }
+  if(index->lineTopology != NULL) {
+    for(i = 0; i < index->lineTopology->lineCount; i++) {
+      free(index->lines[i].windows);
+    }
+  }
+  free(index->locations);
+  free(index->lines);
+  free(index->locationNames);
+  free(index->locationTable);
+  free(index->typeBits);
+  free(index);
+}
+
+// check the sorted windows of a location or line for one that disables a type
+// of incident at a time. A binary search finds the last window starting at or
+// before the time and the windows before it are checked until none of them can
+// reach the time.
+//	loc		- The windows of the location or line
+//	typeId		- The type id of the incident
+//	time		- The time of the incident
+//	ordinal		- The ordinal of the incident's location along the line, NO_STOP
+//			  for the windows of a single location
+//	return		- TRUE if a window disables the incident, FALSE otherwise
+static BOOL disabledWindowsContain(struct DisabledLocation* loc, int typeId, time_t time, int ordinal) {
+  // find the number of windows that start at or before the time
+  int low = 0;
+  int high = loc->windowCount;
+  while(low < high) {
+    int middle = (low + high) / 2;
+    if(loc->windows[middle].start <= time) {
+      low = middle + 1;
+    }
+    else {
+      high = middle;
+    }
+  }
+  int w;
+  for(w = low - 1; w >= 0 && loc->windows[w].maxEnd >= time; w--) {
+    if(ordinal != NO_STOP && (ordinal < loc->windows[w].firstOrdinal || ordinal > loc->windows[w].lastOrdinal)) {
+      continue;
+    }
+    if(loc->windows[w].end >= time &&
+      (loc->windows[w].types[typeId / TYPE_ID_WORD_BITS] >> (typeId % TYPE_ID_WORD_BITS)) & 1ULL) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+// Check the index for a window at a location that disables a type of incident
+// at a time. The location is one hash lookup, then the windows at the location
+// are searched for the bit of the type id. The ranges on each line the location is on are
+// searched the same way, with the ordinal of the location compared to the
+// ordinals of the ends of each range.
+//	index		- The DisabledIncidentIndex
+//	location	- The location of the incident
+//	typeId		- The type id of the incident
+//	time		- The time of the incident
+//	return		- TRUE if the incident is disabled, FALSE otherwise
+BOOL disabledIncidentIndexContains(struct DisabledIncidentIndex* index, const char* location,
+  int typeId, time_t time) {
+  if(typeId == NO_TYPE_ID || typeId >= index->typeWords*TYPE_ID_WORD_BITS) {
+    return FALSE;
+  }
+  int locationSlot = findNameSlot(index->locationTable, index->tableSize, index->locationNames, location);
+  if(index->locationTable[locationSlot] != NO_NAME &&
+    disabledWindowsContain(&index->locations[index->locationTable[locationSlot]], typeId, time, NO_STOP)) {
+    return TRUE;
+  }
+  if(index->lineTopology != NULL) {
+    struct LineTopology* lt = index->lineTopology;
+    int stop;
+    for(stop = findLineTopologyStop(lt, location); stop != NO_STOP; stop = lt->nextStop[stop]) {
+      if(disabledWindowsContain(&index->lines[lt->stopLine[stop]], typeId, time, lt->stopOrdinal[stop])) {
+        return TRUE;
+      }
+    }
+  }
+  return FALSE;
+}
+
+// Check if a DisabledIncident covers a location, either the location is its
+// location1 or it is on the line between location1 and location2
+//	dil		- The Disabled Incident List, holding the LineTopology
+//	din		- The DisabledIncident
+//	location	- The location of the incident
+//	return		- TRUE if the location is covered, FALSE otherwise
+BOOL disabledIncidentCoversLocation(struct DisabledIncidentList* dil, struct DisabledIncident* din,
+  const char* location) {
+  if(strcmp(location, din->location1)==0) {
+    return TRUE;
+  }
+  int line, firstOrdinal, lastOrdinal;
+  findRangeOfDisabledIncident(dil, din, &line, &firstOrdinal, &lastOrdinal);
+  return line != NO_STOP && lineTopologyStopInRange(dil->lineTopology, location, line, firstOrdinal, lastOrdinal);
+}
@@ -1,10 +1,15 @@
 #ifndef DISABLEDINCIDENTS_H
 #define DISABLEDINCIDENTS_H
 #include "StringAndFileMethods.h"
+#include "LineTopology.h"
 
 #define BEFORE_DURATION 700
 #define WITHIN_DURATION 701
 #define AFTER_DURATION 702
+#define NO_NAME -1 // a slot of a name table that does not hold a name
+
+struct Incident;
+struct IncidentTypeList;
 /*
 ** Structures
 ** -----------------------------------------------------
@@ -17,8 +22,11 @@ struct Duration {
 };
 
 // timeElement is the time the incident occured at
-// location is the location, usually a station or interlocking where the
+// location1 is the location, usually a station or interlocking where the
   // incident occured at
+// location2 is the other end of a range of locations, every location on the
+  // line between location1 and location2 is disabled. NULL or empty if only
+  // location1 is disabled
 // data is the track, signal or server name
 // other is a potential field for CTDF incidents to hold the run-number of the
   // train
@@ -34,15 +42,77 @@ struct DisabledIncident {
   struct DisabledIncident* next;
 };
 
+// the time a DisabledIncident is in effect and the incident types it disables
+
+// start and end are the times it starts and ends at
+// maxEnd is the latest end of this window and every window that starts before it
+  // at the same location, once it is before a time no earlier window can hold that time
+// types is a bitset with a bit for each incident type that is disabled, the
+  // bits are numbered by the type ids of the IncidentTypeList
+// firstOrdinal and lastOrdinal are the ordinals along the line of the ends of a
+  // range of locations, a location is in the range if its ordinal is between
+  // them. Both are NO_STOP for a window at a single location
+struct DisabledWindow {
+	time_t start;
+	time_t end;
+	time_t maxEnd;
+	unsigned long long* types;
+	int firstOrdinal;
+	int lastOrdinal;
+};
+
+// every window at one location, sorted by start time
+
+// windowCount is the number of windows
+// windows is the windows
+struct DisabledLocation {
+	int windowCount;
+	struct DisabledWindow* windows;
+};
+
+// An index of a DisabledIncidentList. The disabled incidents are grouped by
+// location through a hash table of location names, and the windows of each
+// location are sorted so the ones holding a time are found with a binary search.
+// Windows that ended before any incident that will be read in are left out.
+
+// typeWords is the number of words in each type bitset
+// locationCount is the number of different locations
+// locationNames is the name of each location
+// locations is the windows of each location, in the same order as locationNames
+// locationTable is a hash table of locationNames, each slot holds an index or NO_NAME
+// tableSize is the number of slots in locationTable, a power of two
+// typeBits is the memory the type bitsets of every window are in
+// lineTopology is the order of the locations along each line, NULL if it was
+  // not read in. It belongs to the DisabledIncidentList
+// lines is the windows of the ranges of locations on each line, in the same
+  // order as the lines of lineTopology
+struct DisabledIncidentIndex {
+	int typeWords;
+	int locationCount;
+	char** locationNames;
+	struct DisabledLocation* locations;
+	int* locationTable;
+	int tableSize;
+	unsigned long long* typeBits;
+	struct LineTopology* lineTopology;
+	struct DisabledLocation* lines;
+};
+
 // container for DisabledIncident structs
 
 // head is the first element
 // tail is the last element
 // count is the number of elements din the linked list
+// index is the DisabledIncidentIndex built by buildDisabledIncidentIndex, NULL
+  // until it is built
+// lineTopology is the order of the locations along each line, used to find
+  // the locations in a range. NULL if it has not been read in
 struct DisabledIncidentList {
 	struct DisabledIncident* head;
 	struct DisabledIncident* tail;
 	int count;
+	struct DisabledIncidentIndex* index;
+	struct LineTopology* lineTopology;
 };
 
 /*
@@ -91,4 +161,21 @@ void changeStationNames(struct DisabledIncidentList* dil);
 // create a complete copy of a DisabledIncident struct
 void copyDisabledIncident(struct DisabledIncident* new_din, struct DisabledIncident* din);
 
+// Index the DisabledIncidentList by location, once the station names have been
+// changed, leaving out windows that ended before pruneBefore
+void buildDisabledIncidentIndex(struct DisabledIncidentList* dil, struct IncidentTypeList* incidentTypeList,
+  time_t pruneBefore);
+
+// free a DisabledIncidentIndex
+void destroyDisabledIncidentIndex(struct DisabledIncidentIndex* index);
+
+// check the index for a window at a location that disables a type of incident at a time
+BOOL disabledIncidentIndexContains(struct DisabledIncidentIndex* index, const char* location,
+  int typeId, time_t time);
+
+// check if a location is location1 of a DisabledIncident or is on the line between
+// location1 and location2
+BOOL disabledIncidentCoversLocation(struct DisabledIncidentList* dil, struct DisabledIncident* din,
+  const char* location);
+
 #endif
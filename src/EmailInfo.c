@@ -20,6 +20,14 @@
 **                      - Modified removeAndDestroyEmailInfo() in order to free SubjectList
 **                      - created Linked-List structs in EmailInfo.h to support new subject line
 **                        - Added bodyFileName and SubjectList* fields to EmailInfo struct
+**
+** 17 Oct 2026: Rev 5.1
+**                      - shouldReceiveEmail checks the type id of the incident against the type
+**                        bitset of the EmailInfo instead of comparing every type name
+**                      - created EmailBuffer to hold what one type of incident adds to the
+**                        emails, created createEmailBuffer, getEmailFragmentStream,
+**                        closeEmailFragment, addSubjectEntry, destroyEmailBuffer and
+**                        appendSummaryEmailList methods
 */
 
 // Initiate linked list of EmailInfo objects
@@ -433,17 +441,10 @@ void readInEmailInfoFile(struct EmailInfoList* el) {
 
 // Check if a person should receive an email give their emailInfoList field.
 //	ei		- The Email info to be checked if it requires and email to be sent to.
-//	typeOfIncident	- The short name of the incident being checked for
+//	typeId		- The type id of the incident being checked for
 //	return		- TRUE if an email should be sent FALSE otherwise
-BOOL shouldReceiveEmail(struct EmailInfo* ei, char* typeOfIncident) {
-  struct TypeOfIncident* tmp = ei->typeOfIncidentList->head;
-  while(tmp != NULL) {
-    if(strcmp(tmp->typeOfIncident,typeOfIncident)==0 || strcmp(tmp->typeOfIncident,ALL)==0 ) {
-      return TRUE; // was found
-    }
-    tmp=tmp->next;
-  }
-  return FALSE; // was not found
+BOOL shouldReceiveEmail(struct EmailInfo* ei, int typeId) {
+  return typeOfIncidentListContainId(ei->typeOfIncidentList, typeId);
 }
 //Sets the Summary Email List to its inital state
 //	sel	- The SummaryEmailList to be created
@@ -511,3 +512,108 @@ void insertIntoSummaryEmailList(struct SummaryEmailList* sel, struct SummaryEmai
 int getCountOfSummaryEmailList(struct SummaryEmailList* sel) {
     return sel->count;
 }
+//Moves every summary email of one list onto the end of another, in order.
+//The list the summary emails are moved from is left empty
+//	sel	- The Summary Email List the summary emails are added to
+//	other	- The Summary Email List the summary emails are moved from
+//	return	- Void
+void appendSummaryEmailList(struct SummaryEmailList* sel, struct SummaryEmailList* other) {
+	if(other->head == NULL) {
+		return;
+	}
+	if(sel->head == NULL) {
+		sel->head = other->head;
+	}
+	else {
+		sel->tail->next = other->head;
+	}
+	sel->tail = other->tail;
+	sel->count += other->count;
+	createSummaryEmailList(other);
+}
+
+// Sets up an EmailBuffer with an empty EmailFragment for each recipient of el
+//	eb	- The EmailBuffer to be created
+//	el	- The list of all email recipients
+//	return	- Void
+void createEmailBuffer(struct EmailBuffer* eb, struct EmailInfoList* el) {
+	eb->fragmentCount = el->count;
+	eb->fragments = calloc(el->count > 0 ? el->count : 1, sizeof(struct EmailFragment));
+	eb->sel = malloc(sizeof(struct SummaryEmailList));
+	createSummaryEmailList(eb->sel);
+}
+
+// Returns the stream to write an EmailFragment's html to, the memory stream
+// is opened the first time something is written
+//	ef	- The EmailFragment of a recipient
+//	return	- The stream, NULL if it could not be opened
+FILE* getEmailFragmentStream(struct EmailFragment* ef) {
+	if(ef->stream == NULL) {
+		ef->stream = open_memstream(&ef->body, &ef->length);
+		if(ef->stream == NULL) {
+			printf("Cannot open a memory stream for an email. Skipping.\n");
+			printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
+		}
+	}
+	return ef->stream;
+}
+
+// Closes the stream of an EmailFragment, after which body holds everything
+// written to it
+//	ef	- The EmailFragment of a recipient
+//	return	- Void
+void closeEmailFragment(struct EmailFragment* ef) {
+	if(ef->stream != NULL) {
+		if(fclose(ef->stream) == EOF) {
+			printf("Cannot close the memory stream of an email.\n");
+			printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
+		}
+		ef->stream = NULL;
+	}
+}
+
+// Adds an incident to the end of the subject entries of an EmailFragment
+//	ef		- The EmailFragment of a recipient
+//	incidentType	- The type of the incident
+//	location	- The location of the incident's DatabaseRecord, copied
+//	data		- The data of the incident's DatabaseRecord, copied
+//	return		- Void
+void addSubjectEntry(struct EmailFragment* ef, const struct IncidentType* incidentType,
+  const char* location, const char* data) {
+	struct SubjectEntry* entry = malloc(sizeof(struct SubjectEntry));
+	entry->incidentType = incidentType;
+	entry->location = (char*)calloc(strlen(location) + 1, sizeof(char));
+	strcpy(entry->location, location);
+	entry->data = (char*)calloc(strlen(data) + 1, sizeof(char));
+	strcpy(entry->data, data);
+	entry->next = NULL;
+	if(ef->subjectHead == NULL) {
+		ef->subjectHead = entry;
+	}
+	else {
+		ef->subjectTail->next = entry;
+	}
+	ef->subjectTail = entry;
+}
+
+// Frees the fragments and summary email list of an EmailBuffer, the
+// EmailBuffer itself is not freed
+//	eb	- The EmailBuffer to be destroyed
+//	return	- Void
+void destroyEmailBuffer(struct EmailBuffer* eb) {
+	int i;
+	for(i = 0; i < eb->fragmentCount; i++) {
+		struct EmailFragment* ef = &eb->fragments[i];
+		closeEmailFragment(ef);
+		free(ef->body);
+		while(ef->subjectHead != NULL) {
+			struct SubjectEntry* entry = ef->subjectHead;
+			ef->subjectHead = entry->next;
+			free(entry->location);
+			free(entry->data);
+			free(entry);
+		}
+	}
+	free(eb->fragments);
+	destroySummaryEmailList(eb->sel);
+}
@@ -8,6 +8,8 @@
   // "email_recipients" and the .html email files before they are sent
 #define ADMIN_GROUP_IDENTIFIER "admin" //identifier for admin group in email_recipients.txt file
 
+struct IncidentType;
+
 
 /*
 ** Structures
@@ -41,6 +43,7 @@ struct EmailInfo {
 //data is the ID of the object that the incident happened to
 //other and extra are bonus fields that are used to store additional info about the incident
 //typeOfIncident is the short name of the incdient the email is about, ie TF, or TLD
+//typeId is the type id of typeOfIncident in the IncidentTypeList
 //tl is the time list of all the times the incident happened
 //next is a pointer to the next summary email (for linked list use)
 struct SummaryEmail {
@@ -50,6 +53,7 @@ struct SummaryEmail {
     char* other;
     char* extra;
     char* typeOfIncident;    
+    int typeId;
     struct TimeList* tl;
     struct SummaryEmail* next;
 };
@@ -108,6 +112,52 @@ struct Location
   struct Location* next;
 };
 
+// An incident that has been emailed about, to be added to a SubjectList with
+// add_to_subject_line once the email it is in is written
+
+// incidentType is the type of the incident
+// location and data are copies of the location and data of its DatabaseRecord
+// next is a pointer to the next element in the linked list
+struct SubjectEntry
+{
+  const struct IncidentType* incidentType;
+  char* location;
+  char* data;
+  struct SubjectEntry* next;
+};
+
+// The part of one recipient's email written while one type of incident is
+// processed. It is added to the recipient's .html file after every type has
+// been processed, see addEmailBufferToEmails
+
+// stream is the memory stream the html is written through, NULL until
+  // something is written
+// body is the html written, once stream is closed
+// length is the length of body
+// subjectHead is the first of the incidents to add to the subject line, in
+  // the order they were written, subjectTail is the last
+struct EmailFragment
+{
+  FILE* stream;
+  char* body;
+  size_t length;
+  struct SubjectEntry* subjectHead;
+  struct SubjectEntry* subjectTail;
+};
+
+// Everything one type of incident adds to the emails, kept apart from the
+// other types so the types can be processed on different threads
+
+// fragmentCount is the number of recipients in the EmailInfoList
+// fragments is the EmailFragment of each recipient, in the order of the EmailInfoList
+// sel is the summary emails read in with the type's database
+struct EmailBuffer
+{
+  int fragmentCount;
+  struct EmailFragment* fragments;
+  struct SummaryEmailList* sel;
+};
+
 /*
 ** Function Prototypes
 ** -----------------------------------------------------
@@ -206,7 +256,7 @@ destroy_location_list(struct LocationList* list);
 void readInEmailInfoFile(struct EmailInfoList* el);
 
 // Check if a person should receive an email give their emailInfoList field.
-BOOL shouldReceiveEmail(struct EmailInfo* ei, char* typeOfIncident);
+BOOL shouldReceiveEmail(struct EmailInfo* ei, int typeId);
 //Sets the Summary Email List to its inital state
 void createSummaryEmailList(struct SummaryEmailList* sel);
 //Removes and frees the memory of the head of the Email Summary List
@@ -217,4 +267,18 @@ void destroySummaryEmailList(struct SummaryEmailList* sel);
 int getCountOfSummaryEmailList(struct SummaryEmailList* sel);
 
 void insertIntoSummaryEmailList(struct SummaryEmailList* sel, struct SummaryEmail* se);
+//Moves every summary email of one list onto the end of another, in order
+void appendSummaryEmailList(struct SummaryEmailList* sel, struct SummaryEmailList* other);
+
+// Sets up an EmailBuffer with an empty EmailFragment for each recipient of el
+void createEmailBuffer(struct EmailBuffer* eb, struct EmailInfoList* el);
+// Returns the stream to write an EmailFragment's html to, opened the first time
+FILE* getEmailFragmentStream(struct EmailFragment* ef);
+// Closes the stream of an EmailFragment so its body can be read
+void closeEmailFragment(struct EmailFragment* ef);
+// Adds an incident to the end of the subject entries of an EmailFragment
+void addSubjectEntry(struct EmailFragment* ef, const struct IncidentType* incidentType,
+  const char* location, const char* data);
+// Frees the fragments and summary email list of an EmailBuffer, not the EmailBuffer itself
+void destroyEmailBuffer(struct EmailBuffer* eb);
 #endif
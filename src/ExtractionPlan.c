@@ -0,0 +1,259 @@
+#include "DatabaseRecord.h"
+#include "ExtractionPlan.h"
+
+/*------------------------------------------------------
+**
+** File: ExtractionPlan.c
+** Created: October 17, 2026
+**
+** Copyright �2015 Toronto Transit Commission
+**
+** Revision History
+**
+** 17 Oct 2026: Rev 5.1
+**                      - This file was introduced in this release
+**                      - parseIncident() used to call getSpecialKeyword() for every special
+**                        keyword, which searched the whole line for the keywords on both
+**                        sides of it. The keyword list of each IncidentType is now compiled
+**                        into an ExtractionPlan that copies every field in one pass
+**                      - The plan reads the line left to right, each keyword is searched for after
+**                        the one before it. The fields are the same as getSpecialKeyword() gave when
+**                        the keywords appear in the line in the order of the keyword list. If they
+**                        are out of order or repeated, getSpecialKeyword() searched the whole line
+**                        for each one and could give different fields, the plan reports the keyword
+**                        it cannot find after the one before it instead
+**
+*/
+
+// find the field of an incident that a special keyword is copied into
+//	incident	-- The incident being filled in
+//	field		-- The letter of the special keyword, K L E or X
+//	return		-- The field, NULL if the letter is not a special keyword
+static char* fieldOfIncident(struct Incident* incident, char field) {
+  switch(field) {
+    case 'K':
+      return incident->data;
+    case 'L':
+      return incident->location;
+    case 'E':
+      return incident->other;
+    case 'X':
+      return incident->extra;
+    default:
+      return NULL;
+  }
+}
+
+// copy the text of a capture into its field. As getSpecialKeyword() did, one
+// space at the start and one at the end of the text are not copied.
+//	line		-- The line the text is in
+//	start		-- The index of the first char of the text
+//	end		-- The index after the last char of the text
+//	field		-- The field the text is copied into
+//	return		-- void
+static void copyCapture(const char* line, int start, int end, char* field) {
+  if(end > start && line[start] == ' ') {
+    start++;
+  }
+  int length = end - start;
+  if(length < 0) {
+    length = 0;
+  }
+  if(length > STRING_LENGTH - 1) {
+    length = STRING_LENGTH - 1;
+  }
+  memcpy(field, line + start, length);
+  field[length] = '\0';
+  if(length > 0 && field[length - 1] == ' ') {
+    field[length - 1] = '\0';
+  }
+}
+
+// the index the text after an anchor starts at. An anchor that ends in a space
+// keeps that space at the start of the text, it is dropped by copyCapture().
+//	step		-- The anchor
+//	offset		-- The index the anchor was found at
+//	return		-- The index the text after the anchor starts at
+static int textAfterAnchor(struct ExtractionStep* step, int offset) {
+  if(step->word[step->length - 1] == ' ') {
+    return offset + step->length - 1;
+  }
+  return offset + step->length;
+}
+
+// the index after the text before an anchor. An anchor that starts with a space
+// leaves that space at the end of the text, it is dropped by copyCapture().
+//	step		-- The anchor
+//	offset		-- The index the anchor was found at
+//	return		-- The index after the last char of the text before the anchor
+static int textBeforeAnchor(struct ExtractionStep* step, int offset) {
+  if(step->word[0] == ' ') {
+    return offset + 1;
+  }
+  return offset;
+}
+
+// Compile the keyword list of an IncidentType into an ExtractionPlan. Each
+// keyword becomes one step, literal keywords are anchors and special keywords
+// (ie; \K) are captures.
+//	keywordList	-- The keyword list of the IncidentType
+//	return		-- The ExtractionPlan, NULL if it could not be allocated
+struct ExtractionPlan* createExtractionPlan(struct KeywordList* keywordList) {
+  struct ExtractionPlan* ep = malloc(sizeof(struct ExtractionPlan));
+  if(ep == NULL) {
+    return NULL;
+  }
+  ep->stepCount = keywordList->count;
+  ep->steps = calloc(ep->stepCount > 0 ? ep->stepCount : 1, sizeof(struct ExtractionStep));
+  if(ep->steps == NULL) {
+    free(ep);
+    return NULL;
+  }
+
+  struct Keyword* keyword = keywordList->head;
+  int s = 0;
+  while(keyword != NULL && s < ep->stepCount) {
+    struct ExtractionStep* step = &ep->steps[s];
+    if(keyword->word[0] == '\\') {
+      step->kind = EXTRACTION_CAPTURE;
+      step->word = NULL;
+      step->length = 0;
+      step->field = keyword->word[1];
+    }
+    else {
+      step->kind = EXTRACTION_ANCHOR;
+      step->word = keyword->word;
+      step->length = strlen(keyword->word);
+    }
+    keyword = keyword->next;
+    s++;
+  }
+
+  //a capture is found by the anchors on either side of it
+  for(s = 0; s < ep->stepCount; s++) {
+    struct ExtractionStep* step = &ep->steps[s];
+    if(step->kind == EXTRACTION_CAPTURE) {
+      BOOL prevIsAnchor = (s == 0) || (ep->steps[s - 1].kind == EXTRACTION_ANCHOR && ep->steps[s - 1].length > 0);
+      BOOL nextIsAnchor = (s == ep->stepCount - 1) || (ep->steps[s + 1].kind == EXTRACTION_ANCHOR && ep->steps[s + 1].length > 0);
+      step->usable = prevIsAnchor && nextIsAnchor;
+      if(!step->usable) {
+        printf("Error : special keyword \\%c is not between two keywords and will always be empty\n", step->field);
+      }
+      //the train # of a UCCR line comes after "Train " rather than after the previous keyword
+      step->quirk = CAPTURE_PLAIN;
+      if(s > 0 && s < ep->stepCount - 1 && ep->steps[s - 1].kind == EXTRACTION_ANCHOR &&
+        contains(ep->steps[s - 1].word, CMD_CC_RESET)) {
+        step->quirk = CAPTURE_AFTER_TRAIN;
+      }
+    }
+  }
+  return ep;
+}
+
+// Free an ExtractionPlan. The anchor keywords belong to the KeywordList.
+//	ep	-- The ExtractionPlan to free
+//	return	-- void
+void destroyExtractionPlan(struct ExtractionPlan* ep) {
+  if(ep == NULL) {
+    return;
+  }
+  free(ep->steps);
+  free(ep);
+}
+
+// Copy every captured field of a line into an incident. The steps are run in
+// order with each anchor searched for after the one before it, a capture waits
+// for the anchor after it to be found and then copies the text between them.
+// An anchor that only appears before the anchor ahead of it in the list is not
+// found, the keywords are expected in the line in the order they are listed.
+// The line starts after the time of the incident.
+//	ep		-- The ExtractionPlan of the incident's IncidentType
+//	incident	-- The incident the fields are copied into
+//	line		-- The line the incident was found in
+//	return		-- void
+void runExtractionPlan(struct ExtractionPlan* ep, struct Incident* incident, const char* line) {
+  //where the search for the next anchor starts
+  int cursor = 0;
+  //the last anchor that was found, NULL if it was not found
+  struct ExtractionStep* lastAnchor = NULL;
+  int lastAnchorText = 0;
+  //the capture waiting for the next anchor and where its text starts
+  struct ExtractionStep* pending = NULL;
+  char* pendingField = NULL;
+  int pendingStart = 0;
+  int s;
+
+  for(s = 0; s < ep->stepCount; s++) {
+    struct ExtractionStep* step = &ep->steps[s];
+    if(step->kind == EXTRACTION_CAPTURE) {
+      char* field = fieldOfIncident(incident, step->field);
+      if(field == NULL) {
+        continue;
+      }
+      //clear field just to be safe
+      int i = 0;
+      while(*(field + i)) {
+        *(field + i) = '\0';
+        i++;
+      }
+      if(!step->usable || (s > 0 && lastAnchor == NULL)) {
+        continue;
+      }
+      int start = s > 0 ? lastAnchorText : 0;
+      if(s < ep->stepCount - 1) {
+        pending = step;
+        pendingField = field;
+        pendingStart = start;
+        continue;
+      }
+      //the last capture runs to the end of the line
+      int end = start;
+      while(line[end] != '\n' && line[end] != '\0') {
+        end++;
+      }
+      //a UCCR line repeats the previous keyword before the CC #
+      const char* reset = findSubstring(line + start, RESET_FOR_TRAIN);
+      if(lastAnchor != NULL && reset != NULL && (int)(reset - line + strlen(RESET_FOR_TRAIN)) <= end) {
+        const char* repeat = findSubstring(line + start, lastAnchor->word);
+        if(repeat == NULL || repeat - line + lastAnchor->length > end) {
+          printf("Error While looking for %s in string %s\n", lastAnchor->word, line);
+          continue;
+        }
+        start = textAfterAnchor(lastAnchor, repeat - line);
+      }
+      copyCapture(line, start, end, field);
+    }
+    else {
+      const char* match = findSubstring(line + cursor, step->word);
+      if(match == NULL) {
+        if(cursor > 0 && findSubstring(line, step->word) != NULL) {
+          printf("Error - %s is only found before the keyword listed ahead of it in string %s\n", step->word, line);
+        }
+        printf("Error While looking for %s in string %s\n", step->word, line);
+        lastAnchor = NULL;
+        pending = NULL;
+        continue;
+      }
+      int offset = match - line;
+      if(pending != NULL && pending->quirk == CAPTURE_AFTER_TRAIN) {
+        //the train # is between "Train " and the next time this anchor appears
+        int tailStart = textAfterAnchor(step, offset);
+        const char* train = findSubstring(line + tailStart, TRAIN_LITERAL);
+        const char* repeat = findSubstring(line + tailStart, step->word);
+        if(train == NULL || repeat == NULL) {
+          printf("Error While looking for %s in string %s\n", TRAIN_LITERAL, line + tailStart);
+        }
+        else {
+          copyCapture(line, (train - line) + strlen(TRAIN_LITERAL) - 1, textBeforeAnchor(step, repeat - line), pendingField);
+        }
+      }
+      else if(pending != NULL) {
+        copyCapture(line, pendingStart, textBeforeAnchor(step, offset), pendingField);
+      }
+      pending = NULL;
+      lastAnchor = step;
+      lastAnchorText = textAfterAnchor(step, offset);
+      cursor = offset + step->length;
+    }
+  }
+}
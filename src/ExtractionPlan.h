@@ -0,0 +1,67 @@
+#ifndef EXTRACTIONPLAN_H
+#define EXTRACTIONPLAN_H
+#include "StringAndFileMethods.h"
+
+#define EXTRACTION_ANCHOR 0 // a literal keyword that is searched for in the line
+#define EXTRACTION_CAPTURE 1 // a special keyword whose text is copied into a field
+#define CAPTURE_PLAIN 0 // the text between the anchors around the capture is copied
+#define CAPTURE_AFTER_TRAIN 1 // the capture follows a "CMD CC Reset" keyword, its
+  // text starts after the "Train " that comes after the next anchor
+#define CMD_CC_RESET "CMD CC Reset" // keyword of the UCCR lines that hold the train #
+#define RESET_FOR_TRAIN "Reset for Train" // text of the UCCR lines that hold the CC #
+#define TRAIN_LITERAL "Train " // constant for the word "Train "
+
+struct Incident;
+struct KeywordList;
+
+/*
+** Structures
+** -----------------------------------------------------
+*/
+
+// One step of an ExtractionPlan, either an anchor or a capture
+
+// kind is EXTRACTION_ANCHOR or EXTRACTION_CAPTURE
+// word is the keyword of an anchor, it points into the KeywordList of the
+  // IncidentType and is NULL for a capture
+// length is the length of word
+// field is the letter of the special keyword of a capture, K L E or X
+// quirk is CAPTURE_PLAIN or CAPTURE_AFTER_TRAIN
+// usable is FALSE for a capture that is next to another capture, there is no
+  // anchor to find its text by so it is always left empty
+struct ExtractionStep {
+  int kind;
+  const char* word;
+  int length;
+  char field;
+  int quirk;
+  BOOL usable;
+};
+
+// An ExtractionPlan is the keyword list of an IncidentType compiled into the
+// order the anchors and captures appear in a log line. The line is passed over
+// once, left to right, finding each anchor after the one before it and copying
+// the text between the anchors into the fields of the incident.
+
+// stepCount is the number of steps
+// steps is every step in the same order as the KeywordList
+struct ExtractionPlan {
+  int stepCount;
+  struct ExtractionStep* steps;
+};
+
+/*
+** Function Prototypes
+** -----------------------------------------------------
+*/
+
+// Compile the keyword list of an IncidentType into an ExtractionPlan
+struct ExtractionPlan* createExtractionPlan(struct KeywordList* keywordList);
+
+// Free an ExtractionPlan
+void destroyExtractionPlan(struct ExtractionPlan* ep);
+
+// Copy every captured field of a line into an incident in one pass over the line
+void runExtractionPlan(struct ExtractionPlan* ep, struct Incident* incident, const char* line);
+
+#endif
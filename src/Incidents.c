@@ -75,6 +75,85 @@
 ** 26 June 2022: Rev 5.0 - MKarlov
 ** 			- Implemented objects for Incident_Types
 **
+** 17 Oct 2026: Rev 5.1
+**                      - records.txt now holds a byte offset checkpoint for the last read line
+**                        readInLogFile() seeks straight to it instead of searching the file
+**                      - created checkpointStillValid method
+**                      - replaced readInLineAndErase with a LogReader that maps the log file
+**                        into memory, created openLogReader, closeLogReader, readInLogLine
+**                        and copyLogLine methods
+**                      - log files are no longer copied to _temp.log with system() before being
+**                        read, the LogReader reads the original file up to the size it had when opened
+**                      - each log folder is read in on its own thread by the new readInFolder method,
+**                        readInFiles merges the results in folder order
+**                      - created appendIncidentList method
+**                      - within_revenue_hours() uses localtime_r so it can be called from any thread
+**                      - containsErrorMessage() uses the KeywordMatcher built at the end of
+**                        readInIncidentTypes() to scan each line once for every incident type
+**                      - readInIncidentTypes() now initializes the keyword and threshold lists
+**                      - contains() and getIndexOfStr() use findSubstring
+**                      - readInFiles() prints how many lines the keyword prefilter let through
+**                      - containsErrorMessage() returns the IncidentType from the list instead of a
+**                        malloc'd copy of it, incidents no longer free their incidentType
+**                      - readInLogFile() parses each incident into reusable buffers and only copies
+**                        the incidents that pass the filters into the arena of the IncidentList,
+**                        created allocateFromIncidentArena and copyIncidentIntoList methods
+**                      - fixed use-after-free of a filtered out incident in readInLogFile()
+**                      - readInDisabledIncidents() sets incidentType to NULL
+**                      - readInIncidentTypes() compiles the keywords of each incident type into an
+**                        ExtractionPlan, parseIncident() runs it to copy every field in one pass,
+**                        reading the line left to right with the keywords in the order they are listed
+**                      - readInLogFile() parses the time of an incident before its other fields
+**                        and checks the revenue hours first, parseIncident() no longer parses it
+**                      - readInLogFile() parses the time with parseTimestamp instead of
+**                        getDateFromString, so the line is no longer moved in memory
+**                      - readInFiles() compiles the filter times into a RevenueHours table with a bit
+**                        for every minute of the week, created buildRevenueHours method
+**                      - within_revenue_hours() looks up the minute of the week of an incident in the
+**                        RevenueHours table instead of calling localtime_r
+**                      - readInDisabledIncidents() builds a DisabledIndex hash table of the disabled
+**                        incidents, checkEnabledDisabled() probes it once for each kind of disabling
+**                        instead of comparing against every disabled incident
+**                      - readInFiles() indexes the temporary disabled incidents by location once their
+**                        station names are changed, checkEnabledDisabled2() looks incidents up in it
+**                      - readInFiles() reads in the LineTopology, checkEnabledDisabled2() disables the
+**                        locations between location1 and location2 of a temporary disabled incident
+**                      - reassignTrackCircuitLocations() looks the location and data of an incident up
+**                        in the hash table of the StationPairList instead of walking the list
+**                      - readInIncidentTypes() gives every incident type a type id, types with the same
+**                        typeOfIncident share one. created findIncidentTypeId and buildTypeOfIncidentBits
+**                        methods, the temporary disabled incidents are checked by type id
+**                      - readInIncidentTypes() compiles the processing flags of each incident type
+**                        into a bitmask, its post parse steps and its table layout. created
+**                        compileProcessingFlags and runPostParseSteps methods, readInLogFile() runs
+**                        the post parse steps instead of searching the flags string for each incident
+**                      - readInFiles() partitions the incident list by type id, created
+**                        partitionIncidentList and getIncidentsOfType methods. processInfo() only
+**                        passes the incidents of its own type to addIncidentsToDatabaseList()
+**                      - determineBgnEndIncidents() and processInfo() pass the position of the first
+**                        time that met a threshold to addIncidentToEmail()
+**                      - determineBgnEndIncidents() finds the first threshold each record meets in one
+**                        sweep of its times and keeps it in the record, processInfo() emails about the
+**                        records that met one instead of checking every threshold a second time
+**                      - determineBgnEndIncidents() keeps the time the thresholds of a record were
+**                        checked up to, so they are only checked against newer times on the next run
+**                      - parseThresholds() reads an optional third number, the size of the buckets of
+**                        time a threshold is checked on. The bucket size is only used if the tool is
+**                        built with BUCKET_THRESHOLDS_ENABLED, since the CSS_Tool_Validation_Program,
+**                        which is not part of this source, is not known to accept it
+**                      - the incident types are processed on a pool of threads, created the
+**                        processTypesOfIncident and processIncidentTypes methods. processInfo() writes
+**                        its emails and summary emails to the EmailBuffer of its type, which are added
+**                        to the emails in list order once every type is processed
+**                      - each FolderReader counts the lines it gives the KeywordMatcher, readInFiles()
+**                        adds the counts up once the threads are joined
+**                      - openLogReader() reads the log file into a buffer with pread instead of mapping
+**                        it, a mapped live log that is truncated while it is read raises SIGBUS
+**                      - readInLogLine() ends the line it hands back with a '\0' in the LogReader's
+**                        memory, readInLogFile() parses it there, removed copyLogLine
+**                      - openLogReader() reads the log file from an offset, readInLogFile() only reads
+**                        the file from its checkpoint onwards unless the checkpoint does not match
+**
 */
 
 //lookup table for connecting uip to hostname
@@ -137,6 +216,114 @@ void createIncidentList(struct IncidentList* il) {
 	il->head = NULL;
 	il->tail = il->head;
 	il->count = 0;
+	il->arena = NULL;
+	il->disabledIndex = NULL;
+	il->typeIdCount = 0;
+	il->typeStart = NULL;
+	il->byType = NULL;
+}
+
+// Move every incident in one list onto the tail of another list, in order.
+// The list the incidents are moved from is left empty.
+//	il	-- The incidentList to have the incidents appended to it
+//	other	-- The incidentList whose incidents will be moved
+//	return	-- void
+void appendIncidentList(struct IncidentList* il, struct IncidentList* other) {
+	if(other->count == 0) {
+		return;
+	}
+	if(il->head == NULL) {
+		il->head = other->head;
+		il->count = other->count;
+	}
+	else {
+		il->tail->next = other->head;
+		il->count += other->count;
+	}
+	il->tail = other->tail;
+	//the incidents are still in the arena of other, so it moves with them
+	if(other->arena != NULL) {
+		struct IncidentArenaBlock* lastBlock = other->arena;
+		while(lastBlock->next != NULL) {
+			lastBlock = lastBlock->next;
+		}
+		if(il->arena == NULL) {
+			il->arena = other->arena;
+		}
+		else {
+			lastBlock->next = il->arena->next;
+			il->arena->next = other->arena;
+		}
+	}
+	createIncidentList(other);
+}
+
+// Hand out memory from the arena of an IncidentList. A new block is started
+// when the current one is full, memory is never given back until the list is
+// destroyed.
+//	il	-- The incidentList whose arena the memory is taken from
+//	size	-- The number of bytes needed
+//	return	-- A pointer to the memory, NULL if a new block could not be allocated
+void* allocateFromIncidentArena(struct IncidentList* il, size_t size) {
+	size = (size + INCIDENT_ARENA_ALIGNMENT - 1) & ~(size_t)(INCIDENT_ARENA_ALIGNMENT - 1);
+	struct IncidentArenaBlock* block = il->arena;
+	if(block == NULL || block->size - block->used < size) {
+		size_t blockSize = size > INCIDENT_ARENA_BLOCK_SIZE ? size : INCIDENT_ARENA_BLOCK_SIZE;
+		block = malloc(sizeof(struct IncidentArenaBlock) + blockSize);
+		if(block == NULL) {
+			printf("ERROR - could not allocate %lu bytes for incidents\n", (unsigned long)blockSize);
+			return NULL;
+		}
+		block->size = blockSize;
+		block->used = 0;
+		//the full block stays in the chain behind the new one
+		block->next = il->arena;
+		il->arena = block;
+	}
+	void* memory = block->data + block->used;
+	block->used += size;
+	return memory;
+}
+
+// Copy an incident into the arena of an IncidentList and insert the copy at the
+// tail of the list. The incident, its TimeElement and its strings are placed in
+// a single allocation with each string only as long as it needs to be.
+//	il	-- The incidentList the copy is inserted into
+//	in	-- The incident to copy, usually held in scratch buffers
+//	return	-- The copy, NULL if there was no memory for it
+struct Incident* copyIncidentIntoList(struct IncidentList* il, struct Incident* in) {
+	//getPrevServer() can leave other as NULL, it stays NULL in the copy
+	size_t locationLength = strlen(in->location) + 1;
+	size_t dataLength = strlen(in->data) + 1;
+	size_t otherLength = in->other != NULL ? strlen(in->other) + 1 : 0;
+	size_t extraLength = strlen(in->extra) + 1;
+	size_t subwayLineLength = strlen(in->subwayLine) + 1;
+	char* memory = allocateFromIncidentArena(il, sizeof(struct Incident) + sizeof(struct TimeElement) +
+		locationLength + dataLength + otherLength + extraLength + subwayLineLength);
+	if(memory == NULL) {
+		return NULL;
+	}
+	struct Incident* copy = (struct Incident*)memory;
+	memory += sizeof(struct Incident);
+	copy->timeElement = (struct TimeElement*)memory;
+	memory += sizeof(struct TimeElement);
+	copy->timeElement->timeObj = in->timeElement->timeObj;
+	copy->location = memcpy(memory, in->location, locationLength);
+	memory += locationLength;
+	copy->data = memcpy(memory, in->data, dataLength);
+	memory += dataLength;
+	copy->other = NULL;
+	if(in->other != NULL) {
+		copy->other = memcpy(memory, in->other, otherLength);
+		memory += otherLength;
+	}
+	copy->extra = memcpy(memory, in->extra, extraLength);
+	memory += extraLength;
+	copy->subwayLine = memcpy(memory, in->subwayLine, subwayLineLength);
+	copy->incidentType = in->incidentType;
+	copy->typeOfIncident = in->incidentType->typeOfIncident;
+	insertIntoIncidentList(il, copy);
+	return copy;
 }
 
 // Standard linked-list Queue style insert at the tail of the list
@@ -157,6 +344,111 @@ void insertIntoIncidentList(struct IncidentList* il, struct Incident* in) {
 	}
 }
 
+// the hash of the fields of an incident that are used by one kind of disabling
+//	kind		-- DISABLED_TYPE, DISABLED_TYPE_LOCATION, DISABLED_TYPE_DATA or DISABLED_TYPE_LOCATION_DATA
+//	type		-- The type of the incident
+//	location	-- The location of the incident
+//	data		-- The data of the incident
+//	return		-- The hash
+static unsigned long hashDisabledKey(int kind, const char* type, const char* location, const char* data) {
+	unsigned long hash = hashStringWithSeed(type, 5381 + kind);
+	if(kind == DISABLED_TYPE_LOCATION || kind == DISABLED_TYPE_LOCATION_DATA) {
+		// the separator keeps "AB","C" and "A","BC" apart
+		hash = hashStringWithSeed(location, hash*33 + ',');
+	}
+	if(kind == DISABLED_TYPE_DATA || kind == DISABLED_TYPE_LOCATION_DATA) {
+		hash = hashStringWithSeed(data, hash*33 + ',');
+	}
+	return hash;
+}
+
+// the kind of disabling a disabled incident is, found from which of its
+// location and data were given
+//	din	-- The disabled incident
+//	return	-- DISABLED_TYPE, DISABLED_TYPE_LOCATION, DISABLED_TYPE_DATA or DISABLED_TYPE_LOCATION_DATA
+static int kindOfDisabledIncident(struct Incident* din) {
+	if(din->location == NULL) {
+		return din->data == NULL ? DISABLED_TYPE : DISABLED_TYPE_DATA;
+	}
+	return din->data == NULL ? DISABLED_TYPE_LOCATION : DISABLED_TYPE_LOCATION_DATA;
+}
+
+// Build the hash table of a list of disabled incidents. The table points at the
+// incidents in the list, so it must be destroyed before the list is.
+//	dil	-- The list of disabled incidents
+//	return	-- The DisabledIndex, NULL if it could not be allocated
+struct DisabledIndex* createDisabledIndex(struct IncidentList* dil) {
+	struct DisabledIndex* index = malloc(sizeof(struct DisabledIndex));
+	if(index == NULL) {
+		return NULL;
+	}
+	// keep the table at most half full
+	index->size = DISABLED_INDEX_MIN_SIZE;
+	while(index->size < dil->count*2) {
+		index->size *= 2;
+	}
+	index->count = 0;
+	memset(index->kindCount, 0, sizeof(index->kindCount));
+	index->entries = calloc(index->size, sizeof(struct DisabledIndexEntry));
+	if(index->entries == NULL) {
+		free(index);
+		return NULL;
+	}
+
+	struct Incident* din = dil->head;
+	while(din != NULL) {
+		int kind = kindOfDisabledIncident(din);
+		unsigned long hash = hashDisabledKey(kind, din->typeOfIncident, din->location, din->data);
+		int slot = hash & (index->size - 1);
+		while(index->entries[slot].din != NULL) {
+			slot = (slot + 1) & (index->size - 1);
+		}
+		index->entries[slot].hash = hash;
+		index->entries[slot].kind = kind;
+		index->entries[slot].din = din;
+		index->kindCount[kind]++;
+		index->count++;
+		din = din->next;
+	}
+	return index;
+}
+
+// free the hash table of a list of disabled incidents, the incidents are not freed
+//	index	-- The DisabledIndex to free
+//	return	-- void
+void destroyDisabledIndex(struct DisabledIndex* index) {
+	if(index == NULL) {
+		return;
+	}
+	free(index->entries);
+	free(index);
+}
+
+// look for a disabled incident of one kind that matches an incident
+//	index		-- The DisabledIndex
+//	kind		-- The kind of disabled incident to look for
+//	type		-- The type of the incident
+//	location	-- The location of the incident
+//	data		-- The data of the incident
+//	return		-- TRUE if there is a matching disabled incident, FALSE otherwise
+static BOOL findInDisabledIndex(struct DisabledIndex* index, int kind, const char* type, const char* location, const char* data) {
+	if(index->kindCount[kind] == 0) {
+		return FALSE;
+	}
+	unsigned long hash = hashDisabledKey(kind, type, location, data);
+	int slot = hash & (index->size - 1);
+	while(index->entries[slot].din != NULL) {
+		struct DisabledIndexEntry* entry = &index->entries[slot];
+		if(entry->hash == hash && entry->kind == kind && strcmp(entry->din->typeOfIncident, type) == 0 &&
+			(entry->din->location == NULL || strcmp(entry->din->location, location) == 0) &&
+			(entry->din->data == NULL || strcmp(entry->din->data, data) == 0)) {
+			return TRUE;
+		}
+		slot = (slot + 1) & (index->size - 1);
+	}
+	return FALSE;
+}
+
 // Incidents (failures at certain tracks, switches or servers) can be disabled 
 // via the file "./Other/Disabled_Incidents.txt"
 // This method will check if a databaseRecord (a struct within a DatabaseList)
@@ -185,6 +477,19 @@ int checkEnabledDisabled(struct IncidentList* dil, struct Incident* in) {
 	{
 		data = in->data;
 	}
+	//with the hash table there is one probe for each kind of disabling
+	if(dil->disabledIndex != NULL)
+	{
+		int kind;
+		for(kind = 0; kind < DISABLED_KINDS; kind++)
+		{
+			if(findInDisabledIndex(dil->disabledIndex, kind, in->typeOfIncident, location, data))
+			{
+				return EMAILS_DISABLED;
+			}
+		}
+		return EMAILS_ENABLED;
+	}
 	while(din != NULL)
 	{
 		//check to see the incidentTypes are the same
@@ -323,7 +628,6 @@ void removeAndDestroyIncident(struct IncidentList* il) {
 	{
 		free(in->subwayLine);
 	}
-	free(in->incidentType);
    	free(in->typeOfIncident);
 	free(in);
 }
@@ -335,46 +639,207 @@ int getCountOfIncidentList(struct IncidentList* il) {
 }
 
 // While the list is not empty, remove and destroy the head element. Lastly
-// destroy the IncidentList object. 
+// destroy the IncidentList object. Incidents that were allocated from the arena
+// of the list are all freed at once with it.
 //	il	-- The incident list which will be deleted
 //	return	-- void
 void destroyIncidentList(struct IncidentList* il) {
+	destroyDisabledIndex(il->disabledIndex);
+	il->disabledIndex = NULL;
+	free(il->typeStart);
+	free(il->byType);
+	il->typeStart = NULL;
+	il->byType = NULL;
+	if(il->arena != NULL) {
+		//the incidents were allocated from the arena and are freed along with it
+		while(il->arena != NULL) {
+			struct IncidentArenaBlock* block = il->arena;
+			il->arena = block->next;
+			free(block);
+		}
+		createIncidentList(il);
+	}
 	while(il->count > 0) {
 		removeAndDestroyIncident(il);
 	}
 	free(il);
 }
 
+// Group the incidents of a list by the type id of their incident type, so the
+// incidents of one type are found without walking the whole list. The incidents
+// are counted by type id and then placed, keeping the order of the list within
+// each type id.
+//	il			-- The incidentList, with every incident read in
+//	incidentTypeList	-- The incident type list that gave out the type ids
+//	return			-- void
+void partitionIncidentList(struct IncidentList* il, struct IncidentTypeList* incidentTypeList) {
+	free(il->typeStart);
+	free(il->byType);
+	il->typeIdCount = incidentTypeList->typeIdCount;
+	il->typeStart = calloc(il->typeIdCount + 1, sizeof(int));
+	il->byType = malloc((il->count + 1)*sizeof(struct Incident*));
+
+	//count the incidents of each type id, an incident without one is left out
+	struct Incident* in = il->head;
+	while(in != NULL) {
+		int typeId = in->incidentType->typeId;
+		if(typeId >= 0 && typeId < il->typeIdCount) {
+			il->typeStart[typeId + 1]++;
+		}
+		in = in->next;
+	}
+	int t;
+	for(t = 0; t < il->typeIdCount; t++) {
+		il->typeStart[t + 1] += il->typeStart[t];
+	}
+
+	//place each incident after the ones of its type id before it
+	int* next = malloc((il->typeIdCount + 1)*sizeof(int));
+	memcpy(next, il->typeStart, (il->typeIdCount + 1)*sizeof(int));
+	in = il->head;
+	while(in != NULL) {
+		int typeId = in->incidentType->typeId;
+		if(typeId >= 0 && typeId < il->typeIdCount) {
+			il->byType[next[typeId]++] = in;
+		}
+		in = in->next;
+	}
+	free(next);
+}
+
+// Get the incidents of one type id from a list partitioned by partitionIncidentList()
+//	il	-- The partitioned incidentList
+//	typeId	-- The type id
+//	count	-- Set to the number of incidents of the type id
+//	return	-- The incidents of the type id, in list order
+struct Incident** getIncidentsOfType(struct IncidentList* il, int typeId, int* count) {
+	if(il->typeStart == NULL || typeId < 0 || typeId >= il->typeIdCount) {
+		*count = 0;
+		return NULL;
+	}
+	*count = il->typeStart[typeId + 1] - il->typeStart[typeId];
+	return il->byType + il->typeStart[typeId];
+}
+
+// Read a log file into memory so its lines can be read with readInLogLine.
+// Only the file from startOffset onwards is read, so resuming at a checkpoint
+// costs only the lines written since. The size of the file is recorded when
+// it is opened and only that much of it is read, which keeps the read
+// consistent while CSS appends to the file.
+// The file is read with pread into a buffer the LogReader owns rather than
+// mapped, since the log is live and a mapping of a file that is truncated or
+// rotated while it is read raises SIGBUS on the pages past its new end. If the
+// file shrinks while it is being read only what could be read is kept.
+//	lr		-- The LogReader that will hold the contents of the file
+//	filePath	-- The file path to the log file to be opened
+//	startOffset	-- The byte offset in the file the LogReader will start at, 0 for
+//			   the whole file
+//	return		-- TRUE if the file was opened, FALSE otherwise
+BOOL openLogReader(struct LogReader* lr, char* filePath, long startOffset) {
+	struct stat st;
+	int fd = open(filePath, O_RDONLY);
+	
+	lr->data = NULL;
+	lr->size = 0;
+	lr->position = 0;
+	lr->startOffset = 0;
+	lr->fileSize = 0;
+	lr->device = 0;
+	lr->inode = 0;
+	lr->lineEnd = NULL;
+	
+	if(fd == -1) {
+		return FALSE;
+	}
+	if(fstat(fd, &st) == -1) {
+		close(fd);
+		return FALSE;
+	}
+	// only the bytes in the file right now are read, anything CSS appends
+	// while the file is being read will be picked up the next time
+	lr->device = (unsigned long)st.st_dev;
+	lr->inode = (unsigned long)st.st_ino;
+	lr->fileSize = (long)st.st_size;
+	if(startOffset > lr->fileSize) {
+		startOffset = lr->fileSize;
+	}
+	lr->startOffset = startOffset;
+	
+	// one more char holds a '\0' after the file, the empty line handed back
+	// at the end of the file
+	size_t wanted = (size_t)(lr->fileSize - startOffset);
+	size_t total = 0;
+	ssize_t res;
+	lr->data = (char*)malloc(wanted + 1);
+	if(lr->data == NULL) {
+		printf("Cannot allocate %lu bytes to read in |%s|\n", (unsigned long)wanted, filePath);
+		close(fd);
+		return FALSE;
+	}
+	while(total < wanted &&
+	  (res = pread(fd, lr->data + total, wanted - total, (off_t)(startOffset + (long)total))) != 0) {
+		if(res == -1) {
+			if(errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		total += (size_t)res;
+	}
+	// the file may have been truncated while being read
+	lr->size = total;
+	lr->data[lr->size] = '\0';
+	close(fd);
+	return TRUE;
+}
+
+// Free the memory held by a LogReader
+//	lr	-- The LogReader to be closed
+//	return	-- Void
+void closeLogReader(struct LogReader* lr) {
+	free(lr->data);
+	lr->data = NULL;
+	lr->size = 0;
+	lr->position = 0;
+	lr->startOffset = 0;
+	lr->lineEnd = NULL;
+}
+
 // lines read in from the logfiles are prefaced by some number of linux characters that are
 // not relevant to the info in the line. This method is design ONLY for reading
-// in lines from the log files as it automatically removes those characters.
-//	fl	-- The file from which the line will be read
-//	line	-- a double pointer string that will be rewritten to hold the line that is read in
-//	size	-- the size of the string in line
+// in lines from the log files as it automatically skips over those characters.
+// Nothing is copied, line is pointed at the first digit of the line within the
+// LogReader's memory and the '\n' that ends it is overwritten with '\0', so the
+// line can be used as a string until the next line is read. If no line is read
+// in, line is pointed at an empty string.
+//	lr	-- The LogReader from which the line will be read
+//	line	-- Will be pointed at the start of the line that is read in
+//	length	-- Will hold the length of the line that is read in
 //	return	-- An int indicating success or failure
-int readInLineAndErase(FILE* fl, char** line, size_t size) {
-	// Initialize line
-	char tempLine[STRING_LENGTH];
-	int i = 0;
-	//clear both tempLine and the line read in
-	while(*((*line) + i))
-	{
-		*((*line) + i) = '\0';
-		i++;
+int readInLogLine(struct LogReader* lr, char** line, size_t* length) {
+	// put back the '\n' of the line that was handed back last time
+	if(lr->lineEnd != NULL) {
+		*(lr->lineEnd) = '\n';
+		lr->lineEnd = NULL;
 	}
-	i = 0;
-	for(i = 0; i < STRING_LENGTH; i++)
-	{
-		tempLine[i] = '\0';
+	
+	char* start = lr->data + lr->position;
+	size_t remaining = lr->size - lr->position;
+	char* end;
+	
+	// the '\0' after the end of the file
+	*line = lr->data + lr->size;
+	*length = 0;
+	
+	if(remaining == 0) {
+		return END_OF_FILE;
 	}
-	i = 0;
-	int character = getc(fl);
+	end = (char*)memchr(start, '\n', remaining);
   
-/*   while the characters being read in are not end of line characters or EOF
-     marker keep reading. A 'proper' file will have an '\n' character at the end
-     of the last last, followed by an EOF marker.
+/*   A 'proper' file will have an '\n' character at the end
+     of the last last, followed by the end of the file.
      therefore, if this method is called again after the last line has been read
-     in it should return EOF right away with a counter value of 0.
+     in it should return END_OF_FILE right away.
      HOWEVER, due to currently unclear circumstances (old technology is believed
      to be the culprit) ocassionally the last line of an 'active' file (one that 
      is still being written to by CSS) may only be half complete before writing 
@@ -396,63 +861,30 @@ int readInLineAndErase(FILE* fl, char** line, size_t size) {
      00:00:04 06/14/15 LOCATION Lawrence INDICATION - SIGNAL 4 CLEAR
      00:00:06 06/14/15 LO
 
-     In this case, the last line will not have and '\n' char before the EOF and
-     is considered a 'suspicious entry' because the counter would not be 0. 
+     In this case, the last line will not have and '\n' char before the end of
+     the file and is considered a 'suspicious entry'.
      Because it may complete once writing to the file recommences it is not a 
      reliable marker as the 'last read line' in the searching and reading method 
-     so it is ignored.
-     
-     Regardless of where the EOF follows a '\n' character or not, END_OF_FILE is
-     returned by this function when it is found.
+     so it is ignored, and the position is left at the start of it.
 */
-  
-	while(character!='\n' && character!=EOF) {
-		// add char to array of chars
-            	tempLine[i] = (char)character;
-		i++;
-		// array may not be big enough to handle line,
-		// if so it is reallocated to twice its size
-		if(i == size-1) {
-			*line = (char*)realloc(*line, size*2);
-			size*=2;
-		}
-		character = getc(fl);
-	}
-
-	// if the end of line character was reached, determine what kind of ending it
-	// was. e.g. suspicious of regular
-	if(character == EOF) {
-		
-		// if the counter, i, is 0, then the file was ended normally, if it was not 0
-		// the last line may only be a partial one or one that was not written out
-		// properly
-		if(i > 0) {	
-			printf("Suspicious entry from readInLineAndErase, line read in and EOF character not prefaced by endofline character. This will be ignored for this iteration\n");
-			printf("%s\n", (*line));
-			return STRANGE_END_OF_FILE;
-		}
-		else {
-			return END_OF_FILE;
-		}
+	if(end == NULL) {
+		printf("Suspicious entry from readInLogLine, line read in and end of file not prefaced by endofline character. This will be ignored for this iteration\n");
+		printf("%.*s\n", (int)remaining, start);
+		return STRANGE_END_OF_FILE;
 	}
+	lr->position += (size_t)(end - start) + 1;
+	*end = '\0';
+	lr->lineEnd = end;
 	
-	char* cleanedLine = tempLine;
-	
-	//move tempLine pointer to the first digit to get rid of junk characters
-	while(isdigit((int)(*cleanedLine)) == 0 && i > 0)
-	{
-		cleanedLine++;
+	//move the start of the line to the first digit to get rid of junk characters
+	while(start < end && isdigit((unsigned char)*start) == 0) {
+		start++;
 	}
-
+	
 	// Most of the time code will follow this execution path
-	if(i > 0) {
-	    //copy string over
-		i = 0;
-		while(*(cleanedLine + i))
-		{
-			*((*line) + i) = *(cleanedLine + i);
-			i++;
-		}		
+	if(start < end) {
+		*line = start;
+		*length = (size_t)(end - start);
 		return READ_IN_STRING;
 	}
 	else {
@@ -469,47 +901,55 @@ int readInLineAndErase(FILE* fl, char** line, size_t size) {
 //	incidentTypeList	-- A list of all the incidentTypes that the program read in
 //	incidentType		-- A double pointer to an incidentType, this incidentType will be filled
 //				   If an incident is found in the string str
+//	keywordStats		-- The counts of the lines given to the KeywordMatcher by this thread
 //	return			-- TRUE if an incident was found, FALSE otherwise
-BOOL containsErrorMessage(char* str, char* msg,struct IncidentTypeList* incidentTypeList,struct IncidentType** incidentType) {
+BOOL containsErrorMessage(char* str, char* msg,struct IncidentTypeList* incidentTypeList,struct IncidentType** incidentType,
+  struct KeywordMatcherStats* keywordStats) {
 	
-    struct IncidentType* incidentTypeListTraveller = incidentTypeList->head;
-    BOOL found;
-    
+    struct IncidentType* matchedType = NULL;
     
-    while(incidentTypeListTraveller != NULL)
+    if(incidentTypeList->keywordMatcher != NULL)
     {
-	//check if the line contains all the keywords for the incidentType
-        found = containsKeywords(incidentTypeListTraveller,str);
-        if(found)
+	//scan the line once for the keywords of every incidentType
+        matchedType = matchKeywords(incidentTypeList->keywordMatcher, str, keywordStats);
+    }
+    else
+    {
+        struct IncidentType* incidentTypeListTraveller = incidentTypeList->head;
+        while(incidentTypeListTraveller != NULL && matchedType == NULL)
         {
-	    printf("Found Error %s in message %s\n",incidentTypeListTraveller->typeOfIncident,str);
-            //clear msg
-            int i = 0;
-            while(*(msg + i))
+	    //check if the line contains all the keywords for the incidentType
+            if(containsKeywords(incidentTypeListTraveller,str))
             {
-                *(msg + i) = '\0';
-                i++;
+                matchedType = incidentTypeListTraveller;
             }
-            //copy incident code into msg
-            i = 0;
-            while(*(incidentTypeListTraveller->typeOfIncident + i))
-            {
-                *(msg + i) = *(incidentTypeListTraveller->typeOfIncident + i);
-                i++;
-            }
-            //copy incidentType
-	    *incidentType = (struct IncidentType*)malloc(sizeof(struct IncidentType));
-            **incidentType = *incidentTypeListTraveller;
-            //end loop
-            incidentTypeListTraveller = NULL;
+            incidentTypeListTraveller = incidentTypeListTraveller->next;
         }
-        else
+    }
+    
+    if(matchedType != NULL)
+    {
+	printf("Found Error %s in message %s\n",matchedType->typeOfIncident,str);
+        //clear msg
+        int i = 0;
+        while(*(msg + i))
         {
-            incidentTypeListTraveller = incidentTypeListTraveller->next;
+            *(msg + i) = '\0';
+            i++;
         }
+        //copy incident code into msg
+        i = 0;
+        while(*(matchedType->typeOfIncident + i))
+        {
+            *(msg + i) = *(matchedType->typeOfIncident + i);
+            i++;
+        }
+        //the incident points at the incidentType in the list
+        *incidentType = matchedType;
+        return TRUE;
     }
     
-    return found;
+    return FALSE;
     
 }
 
@@ -518,37 +958,66 @@ BOOL containsErrorMessage(char* str, char* msg,struct IncidentTypeList* incident
 // may skip some entries that have already been read in and processed.
 //	filePath	-- The file path to the log file to be read
 //	preLastReadLine -- A string of the last line that was read last time the program ran, can be NULL
+//	preCheckpoint	-- The position of preLastReadLine in the log file, can be NULL
 //	il		-- Incident List to be filled with all the newly found incidents
 //	newLastReadLine -- A string that will hold the new last read line in this log file
-//	filterTimes	-- An array of filter times that specify when revenue hours end/begin
+//	newCheckpoint	-- Will hold the position of newLastReadLine and the size of the log file
+//	revenueHours	-- The table of revenue hours built from the filter times
 //	disabledList	-- A list of all disabled incidents
 //	disabledIncidentList	-- A second list of more disabled incidents
 //	spl		-- A list of station names that all incidents will be checked against to change station names
 //	subwayLine	-- The name of the subway line, ie; YUS
 //	incidentTypeList-- A list of all incident types that the program read in, and which will be looked for
+//	keywordStats	-- The counts of the lines given to the KeywordMatcher by this thread
 //	return		-- An int that indicates a sucessful reading or a failed reading
 int readInLogFile(char* filePath, char* preLastReadLine, 
-  struct IncidentList* il, char* newLastReadLine, 
-  struct FilterTime* filterTimes[7], struct IncidentList* disabledList,
+  struct Checkpoint* preCheckpoint, struct IncidentList* il, 
+  char* newLastReadLine, struct Checkpoint* newCheckpoint,
+  struct RevenueHours* revenueHours, struct IncidentList* disabledList,
   struct DisabledIncidentList* disabledIncidentList,
   struct StationPairList* spl, char* subwayLine,
-  struct IncidentTypeList* incidentTypeList) {
-	
-  FILE *logFile;
-  logFile = fopen(filePath, "r");
-
-  if(logFile != NULL) {
-    // tmp will hold the lne that is read in from the file such as:
+  struct IncidentTypeList* incidentTypeList, struct KeywordMatcherStats* keywordStats) {
+  
+  struct LogReader logReader;
+  
+  // If there is a checkpoint only the file from the previously last read line
+  // onwards is read in. The whole file is only read in when there is no
+  // checkpoint, or the line at it is no longer the previously last read line.
+  BOOL useCheckpoint = !(preLastReadLine==NULL || strcmp(preLastReadLine,"")==0) &&
+    preCheckpoint != NULL && preCheckpoint->exists == TRUE && preCheckpoint->offset >= 0;
+
+  if(openLogReader(&logReader, filePath, useCheckpoint ? preCheckpoint->offset : 0)) {
+    // line and lineLength will point at the line read in from the file such as:
     // " �    02:19:06 06/14/15 LOCATION Warden SWITCH 15A CRITICAL DETECTION FAILURE"
-    char* tmp  = (char*)calloc(STRING_LENGTH, sizeof(char));
-		
+    // with the junk characters at the start already skipped over. line is
+    // within the LogReader's memory and is only valid until the next line is
+    // read in
+    char* line;
+    size_t lineLength;
+    
     // errorMsg is the type of error that has been found in the log files
     // CDF, CTDF, TF or PTSLS
     char* errorMsg = (char*)calloc(STRING_LENGTH, sizeof(char));
-		
+    
     // result of readin in a line
     int lineRes;
     
+    // an incident is parsed into these buffers, which are reused for every
+    // matching line. Only incidents that pass every filter are copied into il.
+    char scratchLocation[STRING_LENGTH];
+    char scratchData[STRING_LENGTH];
+    char scratchOther[STRING_LENGTH];
+    char scratchExtra[STRING_LENGTH];
+    char scratchSubwayLine[LINE_LENGTH];
+    struct TimeElement scratchTimeElement;
+    struct Incident scratch;
+    
+    // byte offset of the start of the line held in line, and of the line held
+    // in newLastReadLine. These are saved in newCheckpoint.
+    long lineStart = 0;
+    long lastReadLineStart = 0;
+    
+    newCheckpoint->exists = FALSE;
        
     // If the previously last read line for this file is "" or NULL then there
     // is no previously last read line and we should begin reading in from the 
@@ -556,36 +1025,69 @@ int readInLogFile(char* filePath, char* preLastReadLine,
     // If it is not then we must search until we find the previously last read
     // line and begin reading in from the line after that.
     if( !(preLastReadLine==NULL || strcmp(preLastReadLine,"")==0) ) {
-      // lineRes will be the result of reading in the line, while
-      // tmp will hold the string that was read in.
-      lineRes = readInLineAndErase(logFile, &tmp, STRING_LENGTH);
-			
-      // While the searching function has not found the previously last read
-      // string and has not reached the end of the file, keep searching
-      while( lineRes!=END_OF_FILE && 
-        lineRes!=STRANGE_END_OF_FILE && 
-        strcmp(tmp,preLastReadLine)!=0 ) {
-        
-        lineRes = readInLineAndErase(logFile, &tmp, STRING_LENGTH);
+      BOOL lineFound = FALSE;
+      
+      // If there is a checkpoint the LogReader starts at the offset it holds,
+      // check that it is still the same file and that the line there is still
+      // the previously last read line. Otherwise, or if the line there does
+      // not match, fall back to reading in the whole file and searching from
+      // the start of it.
+      if(useCheckpoint == TRUE) {
+        if(logReader.device == preCheckpoint->device && logReader.inode == preCheckpoint->inode &&
+          logReader.fileSize >= preCheckpoint->fileSize && logReader.startOffset == preCheckpoint->offset) {
+          lineRes = readInLogLine(&logReader, &line, &lineLength);
+          if(lineRes == READ_IN_STRING && hashString(line) == preCheckpoint->lineHash) {
+            lineFound = TRUE;
+            lastReadLineStart = preCheckpoint->offset;
+          }
+        }
+        if(lineFound == FALSE) {
+          printf("Checkpoint at offset %ld does not match the last read line, searching from the start of the file\n", preCheckpoint->offset);
+          closeLogReader(&logReader);
+          if(!openLogReader(&logReader, filePath, 0)) {
+            printf("Cannot open log file |%s|. File will be skipped", filePath);
+            printf("errno = %d\n and strerror is %s\n", errno, strerror(errno));
+            free(errorMsg);
+            return ERROR;
+          }
+        }
       }
       
-      // if the searching algorithm has completed, but the string read in is
-      // not a match for the previously last read line, then the searching
-      // algorithm must have reached the end of the file and not found it.
-      if( strcmp(tmp, preLastReadLine) != 0 ) { 
-        // lineRes must be END_OF_FILE or STRANGE_END_OF_FILE, 
-        // line was not found
-        return LINE_NOT_FOUND; 
+      if(lineFound == FALSE) {
+        // lineRes will be the result of reading in the line, while
+        // line will point at the string that was read in.
+        lineStart = logReader.startOffset + (long)logReader.position;
+        lineRes = readInLogLine(&logReader, &line, &lineLength);
+        
+        // While the searching function has not found the previously last read
+        // string and has not reached the end of the file, keep searching
+        while( lineRes!=END_OF_FILE && 
+          lineRes!=STRANGE_END_OF_FILE && 
+          strcmp(line,preLastReadLine)!=0 ) {
+        
+          lineStart = logReader.startOffset + (long)logReader.position;
+          lineRes = readInLogLine(&logReader, &line, &lineLength);
+        }
+      
+        // if the searching algorithm has completed, but the string read in is
+        // not a match for the previously last read line, then the searching
+        // algorithm must have reached the end of the file and not found it.
+        if( strcmp(line, preLastReadLine) != 0 ) { 
+          // lineRes must be END_OF_FILE or STRANGE_END_OF_FILE, 
+          // line was not found
+          free(errorMsg);
+          closeLogReader(&logReader);
+          return LINE_NOT_FOUND; 
+        }
+        lastReadLineStart = lineStart;
       }
     }
     
     // this will be the first 'new' line.
-    // tmp could be longer then STRING_LENGTH if a previous array reallocated it 
-    // to be double the old size, but for insurance this will ensure arrays do 
-    // not go outside their bounds.
-    lineRes = readInLineAndErase(logFile, &tmp, STRING_LENGTH); 
-    //printf("First 'new' line is: %s\n", tmp);
-		
+    lineStart = logReader.startOffset + (long)logReader.position;
+    lineRes = readInLogLine(&logReader, &line, &lineLength);
+    //printf("First 'new' line is: %s\n", line);
+    
     if(lineRes==END_OF_FILE || lineRes==STRANGE_END_OF_FILE) {
       // 2 case as this point
       
@@ -606,6 +1108,9 @@ int readInLogFile(char* filePath, char* preLastReadLine,
       // so the new last read line will be the same as the old last read line
       else { // a file exists, but we are at the end, so keep a reference to the last entry.
         strcpy(newLastReadLine, preLastReadLine); 
+        newCheckpoint->offset = lastReadLineStart;
+        newCheckpoint->lineHash = hashString(newLastReadLine);
+        newCheckpoint->exists = TRUE;
       }
     }
 
@@ -617,103 +1122,75 @@ int readInLogFile(char* filePath, char* preLastReadLine,
       if(lineRes==READ_IN_STRING) { // STRANGE_END_OF_FILE will not be handled because they are susceptible to changes
         // if lineRes is READ_IN_STRING then we can be sure the string is NOT
         // one of the partial lines that is considered 'suspsicious' by the 
-        // function readInLineAndErase, so it is a reliable lastReadLine marker
+        // function readInLogLine, so it is a reliable lastReadLine marker
         // to save for the next time this tool is ran.
-        strcpy(newLastReadLine, tmp);
+        strcpy(newLastReadLine, line);
+        newCheckpoint->offset = lineStart;
+        newCheckpoint->lineHash = hashString(newLastReadLine);
+        newCheckpoint->exists = TRUE;
         
         struct IncidentType* incidentType;
         
-        if(containsErrorMessage(tmp, errorMsg, incidentTypeList,&incidentType)) {
-          // construct incident
-          struct Incident* in = malloc(sizeof(struct Incident));
-          in->timeElement = malloc(sizeof(struct TimeElement));
-          in->location = (char*)calloc(STRING_LENGTH, sizeof(char));
-          in->data = (char*)calloc(STRING_LENGTH, sizeof(char));
-          in->typeOfIncident = (char*)calloc(STRING_LENGTH, sizeof(char));
-          strcpy(in->typeOfIncident, incidentType->typeOfIncident);
-          in->other = (char*)calloc(STRING_LENGTH, sizeof(char));
-      	  in->extra = (char*)calloc(STRING_LENGTH, sizeof(char));
-      	  in->subwayLine = (char*)calloc(LINE_LENGTH, sizeof(char));
-      	  strcpy(in->subwayLine, subwayLine);
-      	  in->incidentType = incidentType;
+        if(containsErrorMessage(line, errorMsg, incidentTypeList,&incidentType,keywordStats)) {
+          // construct incident in the scratch buffers, the parsing methods
+          // expect every field to start out zeroed
+          struct Incident* in = &scratch;
+          memset(scratchLocation, 0, sizeof(scratchLocation));
+          memset(scratchData, 0, sizeof(scratchData));
+          memset(scratchOther, 0, sizeof(scratchOther));
+          memset(scratchExtra, 0, sizeof(scratchExtra));
+          memset(scratchSubwayLine, 0, sizeof(scratchSubwayLine));
+          strncpy(scratchSubwayLine, subwayLine, LINE_LENGTH - 1);
+          scratchTimeElement.timeObj = 0;
+          in->timeElement = &scratchTimeElement;
+          in->location = scratchLocation;
+          in->data = scratchData;
+          in->other = scratchOther;
+          in->extra = scratchExtra;
+          in->subwayLine = scratchSubwayLine;
+          in->typeOfIncident = incidentType->typeOfIncident;
+          in->incidentType = incidentType;
           in->next = NULL;
-	
-          //get the data from the incident line
-          parseIncident(incidentType,in,tmp);
-          //reassign track locations from WBSS ---> Conventinal
-      	  reassignTrackCircuitLocations(in, spl);
-      	  //checks if this incident needs to figure out the previous server it was on
-      	  if(contains(incidentType->processingFlags,GET_PREVIOUS_SERVER_FLAG))
-      	  {
-      		getPrevServer(in);
-      	  }
-      	  //checks flag if this is a server event, changes name and saves subwayLine as location
-      	  if(contains(incidentType->processingFlags,SERVER_NAME_SWITCH_FLAG))
-      	  {
-      		//copy subwayLine into location for the server incident
-      		int i = 0;
-      		if(*in->location == '\0')
-      		{		
-      			while(*(subwayLine + i))
-      			{
-      				*(in->location + i) = *(subwayLine + i);
-      				i++;
-      			}
-      		}
-      		//switches server names depending on the subwayLine
-      		  switchServerNames(in,subwayLine);
-      	  }
-          else if(contains(incidentType->processingFlags,SERVER_RELATED_INCIDENT)) 
-	  {
-		strcpy(in->other,subwayLine);
-	  }
-	  else 
-	  {
-		  ;//do nothing
-	  }
-      	  //if statment is :
-      	  //( (RevenueHours OR NOT-containsRevenueCheck) AND (checkDisabled1 AND checkDisabled2 ) )
-      	  if( ( within_revenue_hours(in, filterTimes) || !contains(incidentType->processingFlags,REVENUE_HOUR_TIME_CHECK_FLAG) ) && (checkEnabledDisabled(disabledList, in)==EMAILS_ENABLED) && (checkEnabledDisabled2(disabledIncidentList, in) == EMAILS_ENABLED) )
-      	  {
-      	  	insertIntoIncidentList(il,in);
-      	  }
-      	  else
-      	  {
-         	//MEMORY
-         		free(in->data);
-         		free(in->location);
-         		free(in->other);
-			free(in->extra);
-			free(in->subwayLine);
-         		free(in->typeOfIncident);
-         		free(in->timeElement);
-			free(in);
-			free(in->incidentType);
-      	  }
-        }	// end of containsErrorMessage(tmp, errorMsg) check
+          
+          //get the time from the incident line first, an incident that fails the
+          //revenue hours check is dropped before any other field is extracted.
+          //The rest of the line starts after the time.
+          int timeLength = 0;
+          parseTimestamp(line,&(in->timeElement->timeObj),&timeLength);
+          if( !(incidentType->flags & REVENUE_HOUR_TIME_CHECK_BIT) || within_revenue_hours(in, revenueHours) )
+          {
+            //get the rest of the data from the incident line
+            parseIncident(incidentType,in,line + timeLength);
+            //reassign track locations from WBSS ---> Conventinal
+            reassignTrackCircuitLocations(in, spl);
+            //finds the previous server, switches server names or saves the subwayLine,
+            //only the steps the processing flags of the incident type call for are run
+            runPostParseSteps(incidentType, in, subwayLine);
+            //if statment is :
+            //( checkDisabled1 AND checkDisabled2 ), the revenue hours were checked above
+            if( (checkEnabledDisabled(disabledList, in)==EMAILS_ENABLED) && (checkEnabledDisabled2(disabledIncidentList, in) == EMAILS_ENABLED) )
+            {
+              copyIncidentIntoList(il,in);
+            }
+          }
+        }	// end of containsErrorMessage(line, errorMsg) check
       } // end of lineRes==READ_IN_STRING check
       else {
-        printf("ERROR in logs - lineRes is %d, tmp is %s\n", lineRes, tmp);
+        printf("ERROR in logs - lineRes is %d, line is %s\n", lineRes, line);
       }
-      // reallocate tmp to the 'small' size
-      // it could have been made larger for a previous line, but no longer needs
-      // to be that big
-      free(tmp);
-      tmp = (char*)calloc(STRING_LENGTH,sizeof(char)); 
       // read in next line and repeat
-      lineRes = readInLineAndErase(logFile, &tmp, STRING_LENGTH);
-	
+      lineStart = logReader.startOffset + (long)logReader.position;
+      lineRes = readInLogLine(&logReader, &line, &lineLength);
+    
     }    // end of while loop
-    free(tmp);
+    // everything up to here has been read, so this is the size the log file
+    // must at least be next time for the checkpoint to still be valid
+    newCheckpoint->fileSize = logReader.startOffset + (long)logReader.position;
+    newCheckpoint->device = logReader.device;
+    newCheckpoint->inode = logReader.inode;
     free(errorMsg);
-    if(EOF == fclose(logFile)) {
-      printf("Cannot close logFile |%s|. Program will continue.\n", filePath);
-      printf("errno = %d\n and strerror is %s\n", errno, strerror(errno));
-      return ERROR;
-    }
-    else {
-      return lineRes;
-    }
+    closeLogReader(&logReader);
+    return lineRes;
   }
   else {
     printf("Cannot open log file |%s|. File will be skipped", filePath);
@@ -749,6 +1226,145 @@ int getMode(struct Record* rc) {
   }
 }
 
+// checks that a checkpoint still refers to the log file at filePath. A checkpoint
+// is no longer valid if the file was rotated (new device or inode) or truncated
+// (smaller than it was when the checkpoint was saved)
+//	checkpoint	-- The checkpoint read in from records.txt
+//	filePath	-- The file path to the log file the checkpoint was saved for
+//	return		-- TRUE if the checkpoint can still be used, FALSE otherwise
+BOOL checkpointStillValid(struct Checkpoint* checkpoint, char* filePath) {
+  struct stat fileInfo;
+  
+  if(checkpoint->exists == FALSE || stat(filePath, &fileInfo) != 0) {
+    return FALSE;
+  }
+  if((unsigned long)fileInfo.st_dev != checkpoint->device || 
+    (unsigned long)fileInfo.st_ino != checkpoint->inode) {
+    printf("Log file |%s| has been rotated since it was last read\n", filePath);
+    return FALSE;
+  }
+  if((long)fileInfo.st_size < checkpoint->fileSize) {
+    printf("Log file |%s| has been truncated since it was last read\n", filePath);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// Reads in all the log files in one log folder that have not been read in yet,
+// starting from where the last run of the tool stopped. Log folders do not
+// depend on each other, so readInFiles runs this for each folder on its own
+// thread. Everything it reads is kept in the FolderReader until readInFiles
+// merges it, the lists and tables it shares with the other threads are only read.
+//	arg	-- A pointer to the FolderReader for the log folder to be read
+//	return	-- NULL
+void* readInFolder(void* arg) {
+  struct FolderReader* fr = (struct FolderReader*)arg;
+  struct Record* newLastReadLine = fr->newRecord;
+  
+  // Temporary var to hold the complete extension of the file in the folder
+  // that is being read in by the software
+  char* completeFolder = (char*)calloc(STRING_LENGTH, sizeof(char));
+  
+  // based on what was stored for fileName and lastReadLine in
+  // previousRecord, executioin will be different.
+  int mode = getMode(fr->previousRecord);
+  
+  time_t fileDate;
+  
+  // Set fileDate to 24 hours ago and begin reading in information.
+  // this will be done the first time the code runs
+  if(mode == START_UP) {
+    // start with Data from 24 hours ago
+    fileDate = fr->currentTime - 1*24*60*60;
+  }
+  else {
+    // There is a previously read from file that execution can begin with
+    // Copy the fileName from the previousRecord into the fileName
+    // field for the newlastReadLine struct of type Record
+    strcpy(newLastReadLine->fileName, fr->previousRecord->fileName);
+    // get the date from the filename for easier arithmetic and comparing
+    getDateFromFileName(newLastReadLine->fileName, &fileDate);
+    
+    if(mode == MIDDLE_OF_PREVIOUS_FILE) {
+      // there is a previously last read line that execution should begin
+      // from. Lines before this will have already been read in.
+      // copy this line into the lastReadLine field of the struct 
+      // newLastReadLine 
+      strcpy(newLastReadLine->lastReadLine, fr->previousRecord->lastReadLine);
+     
+      sprintf(completeFolder, "%s%s%s", fr->logFolderPath, 
+        newLastReadLine->fileName, DOT_LOG);	
+      
+      // If the log file was rotated or truncated since the checkpoint was
+      // saved, the previously last read line cannot be in it anymore and
+      // the file is read in from the start.
+      int res = LINE_NOT_FOUND;
+      BOOL checkpointValid = checkpointStillValid(&fr->previousRecord->checkpoint, completeFolder);
+      
+      // Attempt to read in the log file and store incidents that are
+      // being searched for in the incident list, 'fr->il'
+      // parsing of lines that contain the error messages that are being
+      // searched for will begin after the line previousRecord->lastReadLine
+      // is found, directly at the checkpoint offset if there is one
+      // the last lines read in this file will be stored in 
+      // newLastReadLine->lastReadLine. This could be the same as 
+      // previousRecord->lastReadLine if not new entries are present.
+      if(checkpointValid == TRUE || fr->previousRecord->checkpoint.exists == FALSE) {
+        res = readInLogFile(completeFolder, fr->previousRecord->lastReadLine, 
+          checkpointValid ? &fr->previousRecord->checkpoint : NULL, fr->il, 
+          newLastReadLine->lastReadLine, &newLastReadLine->checkpoint, fr->revenueHours, fr->disabledList, fr->disabledIncidentList, fr->spl, fr->subwayLine, fr->incidentTypeList, &fr->keywordStats);
+      }
+      
+      // If the previously last read line for this file cannot be found for
+      // some reason, the default behaviour will be to begin at the start of
+      // file and treat all lines that contain error messages as though they
+      // have not be handled yet.
+      // This may cause errors to accidentally appear twice, but none will
+      // be missed.
+      if(res == LINE_NOT_FOUND) {
+        printf("The line, %s, could not be found, beginning at the start of %s\n", 
+        fr->previousRecord->lastReadLine, completeFolder);
+        res = readInLogFile(completeFolder, NULL, NULL, fr->il, 
+        newLastReadLine->lastReadLine, &newLastReadLine->checkpoint, fr->revenueHours, fr->disabledList, fr->disabledIncidentList, fr->spl, fr->subwayLine, fr->incidentTypeList, &fr->keywordStats);
+      }
+      // increment fileDate by 1 hour and prepare to try and read the next
+      // log file
+      fileDate+=1*60*60;
+    }
+    else if(mode == PREVIOUS_FILE_WAS_EMPTY) {
+      // No unique functionality needed. Can immediately enter while loop
+    }
+  }
+
+  while(fileDate <= fr->currentTime) {
+    char* s; //variable for filename - so it can be freed
+    sprintf(completeFolder, "%s%s%s", fr->logFolderPath, s = getFilenameFromDate(fileDate), DOT_LOG);	
+    free(s);
+    FILE* check = fopen(completeFolder, "r");
+    
+    // If this folder exists, then begin reading
+    // if it does not exist, do nothing and increment fileDate
+    if(check != NULL) {
+      fclose(check);
+      // read in the next log file and update the newLastReadLine object
+      // if ERROR is returned, newLastReadLine->lastReadLine will not have
+      // been updated or changed and newLastReadLine->fileName should not be
+      // updated either
+      int res = readInLogFile(completeFolder, NULL, NULL, fr->il, newLastReadLine->lastReadLine, &newLastReadLine->checkpoint, fr->revenueHours, fr->disabledList, fr->disabledIncidentList, fr->spl, fr->subwayLine, fr->incidentTypeList, &fr->keywordStats);
+      if(res != ERROR) {
+        char* s; //tmp var for getFilenameFromDate
+        strcpy(newLastReadLine->fileName, s = getFilenameFromDate(fileDate));
+        free(s);
+      }
+    }
+    // increment fileDate by 1 hour and attempt to read the next file
+    fileDate += 1*60*60;
+  }
+  
+  free(completeFolder);
+  return NULL;
+}
+
 // function to read in ALL necessary log files. 
 // If code has ran previously and is in the middle of an hour then likely only 
 // 1 file will be read from
@@ -799,6 +1415,8 @@ int readInFiles(struct IncidentList* il,struct IncidentTypeList* incidentTypeLis
   printDisabledIncidentList(disabledIncidentList);
   printf("\n");
 
+  // the order of the locations along each line, so a range of locations can be disabled
+  disabledIncidentList->lineTopology = readInLineTopology();
   changeStationNames(disabledIncidentList);
    
   printf("Disabled List (Temporary incidents, after name change)\n");
@@ -879,15 +1497,16 @@ int readInFiles(struct IncidentList* il,struct IncidentTypeList* incidentTypeLis
   }
  
   char logFolderPathsList[NUM_OF_FOLDERS][STRING_LENGTH];
-  char logFolderSubwayLine[NUM_OF_FOLDERS][5];
+  char logFolderSubwayLine[NUM_OF_FOLDERS][LINE_LENGTH];
   i=0;
   
   //null terminate all strings since 4 of the six subwaylines names are only 3 characters long
   //and the other 2 are 4 characters long
   for(i = 0; i < NUM_OF_FOLDERS; i++)
   {
-      logFolderSubwayLine[i][5] = '\0';
-      logFolderSubwayLine[i][4] = '\0';
+      logFolderPathsList[i][0] = '\0';
+      logFolderSubwayLine[i][0] = '\0';
+      logFolderSubwayLine[i][LINE_LENGTH-1] = '\0';
   }
   
   i = 0;
@@ -921,119 +1540,88 @@ int readInFiles(struct IncidentList* il,struct IncidentTypeList* incidentTypeLis
     return ERROR;
   }
   
-  // Temporary vars to hold the complete extension of the folder that is being
-  // read in by the software and to hold that information about where in each
-  // folder (file and line) the software stopped reading at.
-  char* completeFolder = (char*)calloc(STRING_LENGTH, sizeof(char));
-  struct Record* newLastReadLine = malloc(sizeof(struct Record));
-  newLastReadLine->fileName = (char*)calloc(DATE_STRING_LENGTH, sizeof(char));
-  newLastReadLine->lastReadLine = (char*)calloc(STRING_LENGTH, sizeof(char));
+  // Each log folder is read in by its own FolderReader on its own thread.
+  // Every FolderReader fills its own IncidentList and Record, and these are
+  // merged below in folder order once all the threads are done, so the
+  // results are the same as reading the folders one after another.
+  struct FolderReader folderReaders[NUM_OF_FOLDERS];
+  pthread_t folderThreads[NUM_OF_FOLDERS];
+  // the counts of the lines every folder gave to the KeywordMatcher
+  struct KeywordMatcherStats keywordStats = { 0, 0 };
+  BOOL threadStarted[NUM_OF_FOLDERS];
+  
+  // all folders are read up to the same time
+  time_t currentTime = time(NULL) - OFFSET*24*60*60;
+  //printf("The current time is: "); printf(ctime(&currentTime));
+  
+  // the filter times are compiled into a table of every minute of the week
+  // so the revenue hours check does not need localtime
+  struct RevenueHours revenueHours;
+  buildRevenueHours(&revenueHours, filterTimes, currentTime);
   
-  // a string that is passed to system() to copy log files to a temporary folder
-  // so this tool does not interfere with them being written to
-  char* copyCommand = (char*)calloc(STRING_LENGTH, sizeof(char));
+  // index the temporary disabled incidents by location. No incident read in
+  // can be from before the earliest file any folder starts from, so windows
+  // that ended a day before that are left out of the index.
+  time_t earliestFileDate = currentTime - 1*24*60*60;
+  for(i=0; i<NUM_OF_FOLDERS; i++) {
+    time_t fileDate;
+    if(getMode(recordsList[i]) != START_UP && getDateFromFileName(recordsList[i]->fileName, &fileDate) && fileDate < earliestFileDate) {
+      earliestFileDate = fileDate;
+    }
+  }
+  buildDisabledIncidentIndex(disabledIncidentList, incidentTypeList, earliestFileDate - 1*24*60*60);
   
   // Loop should run 6 times
   for(i=0; i<NUM_OF_FOLDERS; i++) {
-    strcpy(newLastReadLine->fileName, ""); // clear
-    strcpy(newLastReadLine->lastReadLine, ""); // clear
+    struct FolderReader* fr = &folderReaders[i];
+    threadStarted[i] = FALSE;
     
-    if(!(logFolderPathsList[i]==NULL || strcmp(logFolderPathsList[i],"")==0)) {
-      
-      // based on what was stored for fileName and lastReadLine in
-      // recordsList[i], executioin will be different.
-      strcpy(tmp,"");
-      int mode = getMode(recordsList[i]);
-  
-      time_t fileDate;
-      
-      time_t currentTime = time(NULL) - OFFSET*24*60*60;
-      //printf("The current time is: "); printf(ctime(&currentTime));
-      
-      // Set fileDate to 24 hours ago and begin reading in information.
-      // this will be done the first time the code runs
-      if(mode == START_UP) {
-        // start with Data from 24 hours ago
-        fileDate = time(NULL) - 1*24*60*60 - OFFSET*24*60*60;
+    fr->logFolderPath = logFolderPathsList[i];
+    fr->subwayLine = logFolderSubwayLine[i];
+    fr->currentTime = currentTime;
+    fr->previousRecord = recordsList[i];
+    fr->newRecord = malloc(sizeof(struct Record));
+    fr->newRecord->fileName = (char*)calloc(DATE_STRING_LENGTH, sizeof(char));
+    fr->newRecord->lastReadLine = (char*)calloc(STRING_LENGTH, sizeof(char));
+    fr->newRecord->checkpoint.exists = FALSE;
+    fr->il = malloc(sizeof(struct IncidentList));
+    createIncidentList(fr->il);
+    fr->revenueHours = &revenueHours;
+    fr->disabledList = disabledList;
+    fr->disabledIncidentList = disabledIncidentList;
+    fr->spl = spl;
+    fr->incidentTypeList = incidentTypeList;
+    fr->keywordStats.linesChecked = 0;
+    fr->keywordStats.linesPassed = 0;
+    
+    if(strcmp(logFolderPathsList[i],"")!=0) {
+      // pthread_create returns the error instead of setting errno
+      int createResult = pthread_create(&folderThreads[i], NULL, readInFolder, fr);
+      if(createResult == 0) {
+        threadStarted[i] = TRUE;
       }
       else {
-        // There is a previously read from file that execution can begin with
-        // Copy the fileName from the recordsList's index 'i' into the fileName
-        // field for the newlastReadLine struct of type Record
-        strcpy(newLastReadLine->fileName, recordsList[i]->fileName);
-        // get the date from the filename for easier arithmetic and comparing
-        getDateFromFileName(newLastReadLine->fileName, &fileDate);
-        
-        if(mode == MIDDLE_OF_PREVIOUS_FILE) {
-          // there is a previously last read line that execution should begin
-          // from. Lines before this will have already been read in.
-          // copy this line into the lastReadLine field of the struct 
-          // newLastReadLine 
-          strcpy(newLastReadLine->lastReadLine, recordsList[i]->lastReadLine);
-         
-          sprintf(completeFolder, "%s%s%s", logFolderPathsList[i], 
-            newLastReadLine->fileName, DOT_LOG);	
-          sprintf(copyCommand, "cp %s %s", completeFolder, TEMP_FILE);
-          system(copyCommand);	
-          
-          // Attempt to read in the log file and store incidents that are
-          // being searched for in the incident, 'il'
-          // parsing of lines that contain the error messages that are being
-          // searched for will begin after the line recordsList[i]->lastReadLine
-          // is found
-          // the last lines read in this file will be stored in 
-          // newLastReadLine->lastReadLine. This could be the same as 
-          // recordsList[i]->lastReadLine if not new entries are present.
-          int res = readInLogFile(TEMP_FILE, recordsList[i]->lastReadLine, il, 
-            newLastReadLine->lastReadLine, filterTimes, disabledList, disabledIncidentList, spl, logFolderSubwayLine[i],incidentTypeList);
-          
-          // If the previously last read line for this file cannot be found for
-          // some reason, the default behaviour will be to begin at the start of
-          // file and treat all lines that contain error messages as though they
-          // have not be handled yet.
-          // This may cause errors to accidentally appear twice, but none will
-          // be missed.
-          if(res == LINE_NOT_FOUND) {
-            printf("The line, %s, could not be found, beginning at the start of %s\n", 
-            recordsList[i]->lastReadLine, completeFolder);
-            res = readInLogFile(TEMP_FILE, NULL, il, 
-            newLastReadLine->lastReadLine, filterTimes, disabledList, disabledIncidentList, spl, logFolderSubwayLine[i],incidentTypeList);
-          }
-          // increment fileDate by 1 hour and prepare to try and read the next
-          // log file
-          fileDate+=1*60*60;
-        }
-        else if(mode == PREVIOUS_FILE_WAS_EMPTY) {
-          // No unique functionality needed. Can immediately enter while loop
-        }
-      }
-
-      while(fileDate <= currentTime) {
-        char* s; //variable for filename - so it can be freed
-        sprintf(completeFolder, "%s%s%s", logFolderPathsList[i], s = getFilenameFromDate(fileDate), DOT_LOG);	
-        free(s);
-        FILE* check = fopen(completeFolder, "r");
-        
-        // If this folder exists, then make a copy of it, and begin reading
-        // if it does not exist, do nothing and increment fileDate
-        if(check != NULL) {
-          fclose(check);
-          sprintf(copyCommand, "cp %s %s", completeFolder, TEMP_FILE);
-          system(copyCommand);	
-          // read in the next log file and update the newLastReadLine object
-          // if ERROR is returned, newLastReadLine->lastReadLine will not have
-          // been updated or changed and newLastReadLine->fileName should not be
-          // updated either
-          int res = readInLogFile(TEMP_FILE, NULL, il, newLastReadLine->lastReadLine, filterTimes, disabledList, disabledIncidentList, spl, logFolderSubwayLine[i],incidentTypeList);
-          if(res != ERROR) {
-            char* s; //tmp var for getFilenameFromDate
-            strcpy(newLastReadLine->fileName, s = getFilenameFromDate(fileDate));
-            free(s);
-          }
-        }
-        // increment fileDate by 1 hour and attempt to read the next file
-        fileDate += 1*60*60;
+        printf("Could not start a thread for %s, it will be read in without one\n", logFolderPathsList[i]);
+        printf("error = %d, strerror is %s\n", createResult, strerror(createResult));
+        readInFolder(fr);
       }
+    }
+  }
+  
+  for(i=0; i<NUM_OF_FOLDERS; i++) {
+    struct FolderReader* fr = &folderReaders[i];
+    struct Record* newLastReadLine = fr->newRecord;
+    
+    if(threadStarted[i] == TRUE) {
+      pthread_join(folderThreads[i], NULL);
+    }
+    
+    if(strcmp(logFolderPathsList[i],"")!=0) {
+      // move this folder's incidents onto the end of the incident list
+      appendIncidentList(il, fr->il);
+      keywordStats.linesChecked += fr->keywordStats.linesChecked;
+      keywordStats.linesPassed += fr->keywordStats.linesPassed;
+      
       printf("%s\n", logFolderPathsList[i]);
       printf("newLastReadLine->lastReadLine = %s\n", newLastReadLine->lastReadLine);
       printf("newLastReadLine->fileName = %s\n\n", newLastReadLine->fileName);
@@ -1047,19 +1635,38 @@ int readInFiles(struct IncidentList* il,struct IncidentTypeList* incidentTypeLis
       else if( newLastReadLine->lastReadLine==NULL || (strcmp(newLastReadLine->lastReadLine, "")==0) ) {
         fprintf(newRecords, "%d,%s\n", i+1, newLastReadLine->fileName);
       }
+      // the checkpoint is written between the fileName and the lastReadLine,
+      // marked with an '@' so it cannot be mistaken for part of the line
+      else if(newLastReadLine->checkpoint.exists == TRUE) {
+        fprintf(newRecords, "%d,%s,@%lu:%lu:%ld:%ld:%lx,%s\n", i+1, newLastReadLine->fileName, 
+          newLastReadLine->checkpoint.device, newLastReadLine->checkpoint.inode,
+          newLastReadLine->checkpoint.fileSize, newLastReadLine->checkpoint.offset,
+          newLastReadLine->checkpoint.lineHash, newLastReadLine->lastReadLine);
+      }
       else {
         fprintf(newRecords, "%d,%s,%s\n", i+1, newLastReadLine->fileName, newLastReadLine->lastReadLine);
       }
-
-      system("rm _temp.log");
     }
     else {
       printf("There appears to be a missing entry in the LogFolderPaths files.\n");
       printf("No entry found corresponding to number '%d'.\n", i+1);
       printf("Please check LogFolderPaths file\n");
     }
+    
+    destroyIncidentList(fr->il);
+    free(newLastReadLine->fileName);
+    free(newLastReadLine->lastReadLine);
+    free(newLastReadLine);
   }
     
+  if(incidentTypeList->keywordMatcher != NULL) {
+    printKeywordMatcherStats(incidentTypeList->keywordMatcher, &keywordStats);
+  }
+
+  // group the incidents by type id, so processInfo() is given only the
+  // incidents of its own type
+  partitionIncidentList(il, incidentTypeList);
+  
   // close the records2.txt and rename it records.txt
   char* filePath = (char*)calloc(STRING_LENGTH, sizeof(char));
   constructLocalFilepath(filePath, OTHER, RECORDS, DOT_TXT);
@@ -1076,8 +1683,6 @@ int readInFiles(struct IncidentList* il,struct IncidentTypeList* incidentTypeLis
   }
   //free things
   free(tmp);
-  free(copyCommand); 
-  free(completeFolder);
   free(filePath2);
   free(filePath3);
   destroyStationPairList(spl);
@@ -1091,9 +1696,6 @@ int readInFiles(struct IncidentList* il,struct IncidentTypeList* incidentTypeLis
   for(i = 0;i<DAYS_OF_WEEK;i++) {
       free(filterTimes[i]);
   }
-  free(newLastReadLine->fileName);
-  free(newLastReadLine->lastReadLine);
-  free(newLastReadLine);
   free(filePath);
 }
 
@@ -1126,6 +1728,7 @@ printf("read in disabled\n");
 	in->extra = NULL;
 	in->subwayLine = NULL;
         in->timeElement = NULL;
+        in->incidentType = NULL;
 	wordHolder = strtok(tmp,COMMA);
 	if(wordHolder == NULL)
 	{
@@ -1175,6 +1778,8 @@ printf("read in disabled\n");
   else {
     printf("The file: '%s' could not be found. No Incidents will be disabled, All incident types will be emailed about\n", filePath);
   }
+  //build the hash table checkEnabledDisabled() looks the incidents up in
+  il->disabledIndex = createDisabledIndex(il);
   //clean things up
   free(filePath);
 }
@@ -1270,6 +1875,7 @@ BOOL readInRecords(struct Record* recordsList[NUM_OF_FOLDERS])
     recordsList[i] = malloc(sizeof(struct Record));
     recordsList[i]->fileName=NULL;
     recordsList[i]->lastReadLine=NULL;
+    recordsList[i]->checkpoint.exists=FALSE;
   }
   
   // check if records.txt even exists, if not, it will be created later in the
@@ -1303,7 +1909,20 @@ BOOL readInRecords(struct Record* recordsList[NUM_OF_FOLDERS])
           strcpy(recordsList[index]->fileName, strtok(NULL,","));
           
           recordsList[index]->lastReadLine = (char*)calloc(STRING_LENGTH, sizeof(char));
-          strcpy(recordsList[index]->lastReadLine, strtok(NULL,"\n"));                  //delimiter chaged to '\n' (Redmine Issue #1579)
+          char* rest = strtok(NULL,"\n");                  //delimiter chaged to '\n' (Redmine Issue #1579)
+          
+          // records written with a checkpoint have it between the fileName and
+          // the lastReadLine in the form "@device:inode:size:offset:hash,".
+          // Log lines always begin with a digit so the '@' is unambiguous.
+          // Records without one are still read in and the line is searched for.
+          int consumed = 0;
+          struct Checkpoint* cp = &recordsList[index]->checkpoint;
+          if(*rest == '@' && sscanf(rest, "@%lu:%lu:%ld:%ld:%lx,%n", &cp->device, 
+            &cp->inode, &cp->fileSize, &cp->offset, &cp->lineHash, &consumed) == 5 && consumed > 0) {
+            cp->exists = TRUE;
+            rest += consumed;
+          }
+          strcpy(recordsList[index]->lastReadLine, rest);
         }
         else {
           // there is no comma, only an index, and there is no previous
@@ -1333,28 +1952,114 @@ BOOL readInRecords(struct Record* recordsList[NUM_OF_FOLDERS])
   free(filePath);
 }
 
+// the number of seconds local time is ahead of UTC at a time
+//	t	-- The time
+//	return	-- The UTC offset in seconds
+static long utcOffsetAt(time_t t) {
+  struct tm localBuffer;
+  localtime_r(&t, &localBuffer);
+  return localBuffer.tm_gmtoff;
+}
+
+// Compile the filter times into a RevenueHours table. Every minute of the week
+// gets the answer the FilterTime of its day would give, and the UTC offsets
+// between REVENUE_HOURS_DAYS_BEFORE days before and REVENUE_HOURS_DAYS_AFTER
+// days after currentTime are found so incidents in that window can be looked
+// up without localtime.
+//	rh		-- The RevenueHours table to be filled
+//	ft		-- An array with the beginning and end of non-revenue hours for each day
+//	currentTime	-- The time log files are read up to
+//	return		-- void
+void buildRevenueHours(struct RevenueHours* rh, struct FilterTime* ft[7], time_t currentTime) {
+  int day, hour, min;
+  memset(rh->minutes, 0, sizeof(rh->minutes));
+  for(day = 0; day < DAYS_OF_WEEK; day++) {
+    for(hour = 0; hour < 24; hour++) {
+      for(min = 0; min < 60; min++) {
+        BOOL withinRevenueHours = TRUE;
+        if(ft[day]->timesExist == TRUE) {
+          BOOL afterStartTime = (ft[day]->startTime.tm_hour < hour) ||
+            ((ft[day]->startTime.tm_hour == hour) && (ft[day]->startTime.tm_min <= min));
+          BOOL beforeEndTime = (ft[day]->endTime.tm_hour > hour) ||
+            ((ft[day]->endTime.tm_hour == hour) && (ft[day]->endTime.tm_min >= min));
+          withinRevenueHours = !(afterStartTime && beforeEndTime);
+        }
+        if(withinRevenueHours) {
+          int minute = day*MINUTES_IN_DAY + hour*60 + min;
+          rh->minutes[minute / REVENUE_HOURS_WORD_BITS] |= 1u << (minute % REVENUE_HOURS_WORD_BITS);
+        }
+      }
+    }
+  }
+
+  // find every change of UTC offset in the window an hour at a time, then the
+  // exact second it happens at
+  rh->windowStart = currentTime - REVENUE_HOURS_DAYS_BEFORE*24*60*60;
+  rh->windowEnd = currentTime + REVENUE_HOURS_DAYS_AFTER*24*60*60;
+  rh->offsetCount = 1;
+  rh->offsetStart[0] = rh->windowStart;
+  rh->offset[0] = utcOffsetAt(rh->windowStart);
+  time_t t;
+  for(t = rh->windowStart + 3600; t < rh->windowEnd; t += 3600) {
+    long offset = utcOffsetAt(t);
+    if(offset != rh->offset[rh->offsetCount - 1]) {
+      if(rh->offsetCount == MAX_UTC_OFFSETS) {
+        // the rest of the window is checked with localtime
+        rh->windowEnd = t - 3600;
+        break;
+      }
+      time_t before = t - 3600;
+      time_t after = t;
+      while(after - before > 1) {
+        time_t middle = before + (after - before)/2;
+        if(utcOffsetAt(middle) == rh->offset[rh->offsetCount - 1]) {
+          before = middle;
+        }
+        else {
+          after = middle;
+        }
+      }
+      rh->offsetStart[rh->offsetCount] = after;
+      rh->offset[rh->offsetCount] = offset;
+      rh->offsetCount++;
+    }
+  }
+}
+
+// the minute of the week a time is in, in local time, starting at 00:00 Sunday
+//	rh	-- The RevenueHours table with the UTC offsets around the current time
+//	t	-- The time
+//	return	-- The minute of the week
+static int minuteOfWeek(struct RevenueHours* rh, time_t t) {
+  if(t >= rh->windowStart && t < rh->windowEnd) {
+    int i = rh->offsetCount - 1;
+    while(i > 0 && t < rh->offsetStart[i]) {
+      i--;
+    }
+    long long local = (long long)t + rh->offset[i];
+    long long days = local / (24*60*60);
+    long long seconds = local % (24*60*60);
+    if(seconds < 0) {
+      seconds += 24*60*60;
+      days--;
+    }
+    int weekday = (int)(((days + EPOCH_WEEKDAY) % DAYS_OF_WEEK + DAYS_OF_WEEK) % DAYS_OF_WEEK);
+    return weekday*MINUTES_IN_DAY + (int)(seconds / 60);
+  }
+  // outside of the window the UTC offset is not known
+  struct tm inTimeBuffer;
+  struct tm* inTime = localtime_r(&t, &inTimeBuffer);
+  return inTime->tm_wday*MINUTES_IN_DAY + inTime->tm_hour*60 + inTime->tm_min;
+}
+
 // check to see if an incident occured during revenue hours or working hours 
 // if it was during working hours, then it is ignored.
 //	in	-- The incident being checked.
-//	ft	-- An array with the beginning and end of revenue hours for each day.
+//	rh	-- The table of revenue hours built from the filter times.
 //	return	-- FALSE if outside of revenue Hours, TRUE if within revenue hours (most incidents).
-BOOL within_revenue_hours(struct Incident* in, struct FilterTime* ft[7]) {
-  struct tm* inTime = localtime(&(in->timeElement->timeObj));
-
-  if( ft[inTime->tm_wday]->timesExist == TRUE ) {
-    BOOL afterStartTime = (ft[inTime->tm_wday]->startTime.tm_hour < inTime->tm_hour) ||
-      ((ft[inTime->tm_wday]->startTime.tm_hour == inTime->tm_hour) && 
-      (ft[inTime->tm_wday]->startTime.tm_min <=  inTime->tm_min));
-		
-    BOOL beforeEndTime  = (ft[inTime->tm_wday]->endTime.tm_hour > inTime->tm_hour) ||
-      ((ft[inTime->tm_wday]->endTime.tm_hour == inTime->tm_hour) && 
-      (ft[inTime->tm_wday]->endTime.tm_min >=  inTime->tm_min));
-
-		return !(afterStartTime && beforeEndTime);
-	}
-	else {
-		return TRUE;
-	}
+BOOL within_revenue_hours(struct Incident* in, struct RevenueHours* rh) {
+  int minute = minuteOfWeek(rh, in->timeElement->timeObj);
+  return (rh->minutes[minute / REVENUE_HOURS_WORD_BITS] >> (minute % REVENUE_HOURS_WORD_BITS)) & 1u;
 }
 
 // Certain tracks sections or switches are considered to be in work yards from the point
@@ -1382,24 +2087,14 @@ BOOL reassignTrackCircuitLocations(struct Incident* in, struct StationPairList*
   }
 
   
-  BOOL locMatch;
-  BOOL dataMatch;
-  struct StationPair* sp = spl->head;
-  // cycle through the StationPairList and check if
-  // it contains the Incident 'in'. If it does, change
-  // the Incident's fields and return true.  
-  while(sp != NULL) {
-    // if the 'convName' field of the StationPair matches the 
-    // name of the location for the disbled incident, copy the
-    // proper wbss name into it
-    locMatch = strcmp(in->location, sp->location2)==0;
-    dataMatch = strcmp(in->data, sp->data2)==0;
-    if(locMatch && dataMatch) {
-      strcpy(in->location, sp->location1);
-      strcpy(in->data, sp->data1);
-      return TRUE;
-    }
-    sp=sp->next;
+  // look up the WBSS location and data of the Incident 'in' in the
+  // StationPairList. If it is there, change the Incident's fields
+  // to the user-defined ones and return true.
+  struct StationPair* sp = findStationPair(spl, in->location, in->data);
+  if(sp != NULL) {
+    strcpy(in->location, sp->location1);
+    strcpy(in->data, sp->data1);
+    return TRUE;
   }
   
   // Location and data matching 'in' was not found in 
@@ -1410,29 +2105,38 @@ BOOL reassignTrackCircuitLocations(struct Incident* in, struct StationPairList*
 //Determines which Incidents are head incidents, and which incidents are tail incidents
 //Accounting only for eligible incidents
 //Necessary for determing the start and end of HTML tables
-void determineBgnEndIncidents(struct DatabaseRecord* dr,struct Threshold* th,struct DatabaseList* databaseList, struct ThresholdList* thresholdList){
+//The first threshold each record meets and the start of its block are kept in
+//the record, so processInfo() does not have to check the thresholds again
+//	databaseList	-- The Database List with the new incidents merged in
+//	thresholdList	-- The thresholds of the type of incident
+//	return		-- void
+void determineBgnEndIncidents(struct DatabaseList* databaseList, struct ThresholdList* thresholdList){
 
-    struct DatabaseRecord* prevdr=databaseList->head; 
+    struct DatabaseRecord* prevdr = NULL;
+    struct DatabaseRecord* dr = databaseList->head;
 
     while(dr != NULL) {
-      while(th != NULL) {
-        struct TimeElement* start;
-        int thresholdResult = checkThresholdCondition(th, dr, &start);
-        int emailStatus = checkEmailStatus(dr);
-
-        if(thresholdResult==CONDITION_MET && emailStatus==EMAIL_NOT_SENT_YET)
+      dr->lastRecord = FALSE;
+      dr->thresholdMet = NULL;
+      // a record that has already been emailed about is not eligible
+      if(checkEmailStatus(dr) == EMAIL_NOT_SENT_YET)
+      {
+        dr->thresholdMet = findFirstThresholdMet(thresholdList, dr, &dr->thresholdStart);
+        // none of its blocks meet a threshold, they are not checked again
+        if(dr->thresholdMet == NULL && dr->timeList->count > 0)
         {
-		dr->lastRecord = TRUE;
-		if( prevdr != dr){
-			prevdr->lastRecord = FALSE;
-			prevdr=dr;
-		}
-	}
-	th=th->next;
+          dr->thresholdsCheckedTo = getTime(dr->timeList, dr->timeList->count - 1);
+        }
+      }
+      if(dr->thresholdMet != NULL)
+      {
+        prevdr = dr;
       }
-      th = thresholdList->head;
       dr=dr->next;
    }
+   if(prevdr != NULL) {
+     prevdr->lastRecord = TRUE;
+   }
 }
 // Read in ThresholdList and DatabaseList associated with this type of incident
 // and merge the new incidents that have been read in from the log files into
@@ -1440,12 +2144,13 @@ void determineBgnEndIncidents(struct DatabaseRecord* dr,struct Threshold* th,str
 // been emailed about before and if these conditions are all met, prepare an
 // email to send.
 //	typeOfIncident	-- A stirng that contains the short name of the incident
-//	incidentList	-- A list with all the found incidents
+//	incidentList	-- A list with all the found incidents, partitioned by type id
 //	emailInfoList	-- A list with the email info of all possible recipients
-//	sel		-- A list for summary emails (incidents added to this list if they need a summary email)
+//	emailBuffer	-- The EmailBuffer of this type, the emails and summary emails (incidents added
+//			   to its list if they need a summary email) are written to it
 //	incidentType	-- The type of incident that will be checked this run through process info
 //	return		-- void 
-struct DatabaseList* processInfo(char* typeOfIncident, struct IncidentList* incidentList, struct EmailInfoList* emailInfoList, struct SummaryEmailList* sel, struct IncidentType* incidentType, struct CCPair* ccPairLLHead){
+struct DatabaseList* processInfo(char* typeOfIncident, struct IncidentList* incidentList, struct EmailInfoList* emailInfoList, struct EmailBuffer* emailBuffer, struct IncidentType* incidentType, struct CCMapping* ccMapping){
 	printf("--------------------START--------------------\n\n");
     printf("Type: %s\n", typeOfIncident);
 
@@ -1463,7 +2168,7 @@ struct DatabaseList* processInfo(char* typeOfIncident, struct IncidentList* inci
     createDatabaseList(databaseList);
 
     //If onboard incident
-    if(contains(incidentType->processingFlags, ONBOARD_INCIDENT_FLAG))
+    if(incidentType->flags & ONBOARD_INCIDENT_BIT)
     {
       databaseList->isOnBoardIncident = TRUE;
     }
@@ -1471,12 +2176,16 @@ struct DatabaseList* processInfo(char* typeOfIncident, struct IncidentList* inci
     {
       databaseList->isOnBoardIncident = FALSE;
     }
-    readInDBFile(typeOfIncident, databaseList, getExpiringTime(thresholdList), sel, incidentType);
+    readInDBFile(typeOfIncident, databaseList, getExpiringTime(thresholdList), emailBuffer->sel, incidentType);
 
     // Incidents of the same type as 'databaseList' are added to database list.
     // databaseList will later be printed out to a file and replace the old
     // database file.
-    addIncidentsToDatabaseList(typeOfIncident, databaseList, incidentList);
+    // only the incidents of this type are looked at, the list was partitioned
+    // by type id when it was read in
+    int incidentCount;
+    struct Incident** incidents = getIncidentsOfType(incidentList, incidentType->typeId, &incidentCount);
+    addIncidentsToDatabaseList(incidentType, databaseList, incidents, incidentCount);
     
     printf("Database List after merge, before sending emails\n");
     printDatabaseList(databaseList);
@@ -1484,35 +2193,23 @@ struct DatabaseList* processInfo(char* typeOfIncident, struct IncidentList* inci
  
     // Check Thresholds and Email Status and if Disabled
     // Prepare .html documents
-    struct DatabaseRecord* dr = databaseList->head;
-    struct Threshold* th = thresholdList->head;
-    
-    determineBgnEndIncidents(dr,th,databaseList,thresholdList);
+    determineBgnEndIncidents(databaseList,thresholdList);
 
-    dr = databaseList->head;
-    th = thresholdList->head;
+    struct DatabaseRecord* dr = databaseList->head;
     databaseList->headerExists = FALSE; 
 
     while(dr != NULL) {
-      while(th != NULL) {
-        struct TimeElement* start;
-        int thresholdResult = checkThresholdCondition(th, dr, &start);
-        int emailStatus = checkEmailStatus(dr);
-
-        // if the database record has met a threshold condition, is not disabled 
-        // and has not already been emailed about then it is added to the
-        // html files of each person is 'emailInfoList' who is supposed to
-        // receive emails about this type of incident
-        if(thresholdResult==CONDITION_MET && emailStatus==EMAIL_NOT_SENT_YET)
-        {
-         addIncidentToEmail(dr, th, emailInfoList, start, incidentType, ccPairLLHead, databaseList->headerExists);
-	 databaseList->headerExists = TRUE;
-         strcpy(dr->flag->msg, EMAIL);
-         dr->flag->timeOfEmail = time(NULL) - OFFSET*24*60*60;
-        }
-        th=th->next;
-      } // end of threshold conditions while loop
-      th = thresholdList->head;
+      // if the database record has met a threshold condition, is not disabled 
+      // and has not already been emailed about then it is added to the
+      // html files of each person is 'emailInfoList' who is supposed to
+      // receive emails about this type of incident
+      if(dr->thresholdMet != NULL)
+      {
+       addIncidentToEmail(dr, dr->thresholdMet, emailInfoList, emailBuffer, dr->thresholdStart, incidentType, ccMapping, databaseList->headerExists);
+       databaseList->headerExists = TRUE;
+       strcpy(dr->flag->msg, EMAIL);
+       dr->flag->timeOfEmail = time(NULL) - OFFSET*24*60*60;
+      }
       dr=dr->next;
     } // end of databaseList while loop
     printDatabaseToFile(typeOfIncident, databaseList);
@@ -1521,6 +2218,107 @@ struct DatabaseList* processInfo(char* typeOfIncident, struct IncidentList* inci
     return databaseList;
 } 
 
+// Take type ids from a TypeProcessor until there are none left. The
+// incidentTypes with a type id are processed one after another, in list
+// order, since each one reads the database file the one before it wrote.
+//	arg	-- The TypeProcessor shared by every thread
+//	return	-- NULL
+void* processTypesOfIncident(void* arg) {
+    struct TypeProcessor* tp = (struct TypeProcessor*)arg;
+
+    while(TRUE) {
+      pthread_mutex_lock(&tp->lock);
+      int typeId = tp->nextTypeId++;
+      pthread_mutex_unlock(&tp->lock);
+      if(typeId >= tp->typeIdCount) {
+        break;
+      }
+
+      int i;
+      for(i = 0; i < tp->typeCount; i++) {
+        struct IncidentType* incidentType = tp->incidentTypes[i];
+        if(incidentType->typeId == typeId) {
+          processInfo(incidentType->typeOfIncident, tp->incidentList, tp->emailInfoList, &tp->emailBuffers[i], incidentType, tp->ccMapping);
+        }
+      }
+    }
+    return NULL;
+}
+
+// Run processInfo for every incidentType. Types with different type ids read
+// and write different database files, so they are spread across a pool of
+// threads, one for each processor, with this thread as one of them. Each type
+// writes its emails and summary emails to its own EmailBuffer, and the buffers
+// are added to the emails and to 'sel' in the order of the IncidentTypeList
+// once every type is done, so the results are the same as processing the
+// types one after another.
+//	incidentTypeList	-- The incident type list, with type ids assigned
+//	incidentList		-- A list with all the found incidents, partitioned by type id
+//	emailInfoList		-- A list with the email info of all possible recipients
+//	sel			-- The list of summary emails to be sent
+//	return			-- void
+void processIncidentTypes(struct IncidentTypeList* incidentTypeList, struct IncidentList* incidentList,
+  struct EmailInfoList* emailInfoList, struct SummaryEmailList* sel, struct CCMapping* ccMapping) {
+    struct TypeProcessor tp;
+    int i;
+
+    tp.typeCount = incidentTypeList->count;
+    tp.typeIdCount = incidentTypeList->typeIdCount;
+    tp.nextTypeId = 0;
+    tp.incidentList = incidentList;
+    tp.emailInfoList = emailInfoList;
+    tp.ccMapping = ccMapping;
+    tp.incidentTypes = malloc((tp.typeCount + 1)*sizeof(struct IncidentType*));
+    tp.emailBuffers = malloc((tp.typeCount + 1)*sizeof(struct EmailBuffer));
+    pthread_mutex_init(&tp.lock, NULL);
+
+    struct IncidentType* incidentType = incidentTypeList->head;
+    for(i = 0; i < tp.typeCount && incidentType != NULL; i++) {
+      tp.incidentTypes[i] = incidentType;
+      createEmailBuffer(&tp.emailBuffers[i], emailInfoList);
+      incidentType = incidentType->next;
+    }
+
+    // this thread is one of the pool, so one fewer thread is started
+    long threadCount = sysconf(_SC_NPROCESSORS_ONLN) - 1;
+    if(threadCount > tp.typeIdCount - 1) {
+      threadCount = tp.typeIdCount - 1;
+    }
+    if(threadCount < 0) {
+      threadCount = 0;
+    }
+    pthread_t* typeThreads = malloc((threadCount + 1)*sizeof(pthread_t));
+    long threadsStarted = 0;
+    while(threadsStarted < threadCount) {
+      // pthread_create returns the error instead of setting errno
+      int createResult = pthread_create(&typeThreads[threadsStarted], NULL, processTypesOfIncident, &tp);
+      if(createResult != 0) {
+        printf("Could not start a thread to process incident types, %ld threads are used\n", threadsStarted + 1);
+        printf("error = %d, strerror is %s\n", createResult, strerror(createResult));
+        break;
+      }
+      threadsStarted++;
+    }
+
+    processTypesOfIncident(&tp);
+
+    for(i = 0; i < threadsStarted; i++) {
+      pthread_join(typeThreads[i], NULL);
+    }
+
+    // add what each type wrote in list order
+    for(i = 0; i < tp.typeCount; i++) {
+      addEmailBufferToEmails(&tp.emailBuffers[i], emailInfoList, ccMapping);
+      appendSummaryEmailList(sel, tp.emailBuffers[i].sel);
+      destroyEmailBuffer(&tp.emailBuffers[i]);
+    }
+
+    pthread_mutex_destroy(&tp.lock);
+    free(typeThreads);
+    free(tp.emailBuffers);
+    free(tp.incidentTypes);
+}
+
 // sets the linked list to its default setting - empty
 //	incidentTypeList	- The Incident Type List to be created
 //	return			- Void
@@ -1529,6 +2327,12 @@ void createIncidentTypeList(struct IncidentTypeList* incidentTypeList)
     incidentTypeList->head = NULL;
     incidentTypeList->tail = NULL;
     incidentTypeList->count = 0;
+    incidentTypeList->keywordMatcher = NULL;
+    incidentTypeList->typeIdCount = 0;
+    incidentTypeList->byId = NULL;
+    incidentTypeList->typeIdTable = NULL;
+    incidentTypeList->typeIdTableSize = 0;
+    incidentTypeList->typeWords = 1;
 }
 
 //Alteration of the gcc strtok function
@@ -1561,10 +2365,231 @@ char* strtoke(char *str, const char *delim){
       return token;
 }
 
+// find the slot of a typeOfIncident in the hash table of type ids, either the
+// slot holding its type id or the empty slot it would go in
+//	incidentTypeList	-- The incident type list
+//	typeOfIncident		-- The short name of the type of incident
+//	return			-- The slot
+static int findTypeIdSlot(struct IncidentTypeList* incidentTypeList, const char* typeOfIncident)
+{
+    int slot = hashString(typeOfIncident) & (incidentTypeList->typeIdTableSize - 1);
+    while(incidentTypeList->typeIdTable[slot] != NO_TYPE_ID &&
+        strcmp(incidentTypeList->byId[incidentTypeList->typeIdTable[slot]]->typeOfIncident, typeOfIncident) != 0)
+    {
+        slot = (slot + 1) & (incidentTypeList->typeIdTableSize - 1);
+    }
+    return slot;
+}
+
+// give every incidentType in the list a type id, in the order of the list.
+// Types with the same typeOfIncident share the id of the first of them.
+//	incidentTypeList	-- The incident type list, with every incidentType read in
+//	return			-- void
+static void assignIncidentTypeIds(struct IncidentTypeList* incidentTypeList)
+{
+    incidentTypeList->typeIdTableSize = 16;
+    while(incidentTypeList->typeIdTableSize < 2*incidentTypeList->count)
+    {
+        incidentTypeList->typeIdTableSize *= 2;
+    }
+    incidentTypeList->typeIdTable = malloc(incidentTypeList->typeIdTableSize*sizeof(int));
+    int i;
+    for(i = 0; i < incidentTypeList->typeIdTableSize; i++)
+    {
+        incidentTypeList->typeIdTable[i] = NO_TYPE_ID;
+    }
+    incidentTypeList->byId = malloc((incidentTypeList->count + 1)*sizeof(struct IncidentType*));
+    incidentTypeList->typeIdCount = 0;
+
+    struct IncidentType* incidentType = incidentTypeList->head;
+    while(incidentType != NULL)
+    {
+        int slot = findTypeIdSlot(incidentTypeList, incidentType->typeOfIncident);
+        if(incidentTypeList->typeIdTable[slot] == NO_TYPE_ID)
+        {
+            incidentTypeList->byId[incidentTypeList->typeIdCount] = incidentType;
+            incidentTypeList->typeIdTable[slot] = incidentTypeList->typeIdCount;
+            incidentTypeList->typeIdCount++;
+        }
+        incidentType->typeId = incidentTypeList->typeIdTable[slot];
+        incidentType = incidentType->next;
+    }
+    incidentTypeList->typeWords = (incidentTypeList->typeIdCount + TYPE_ID_WORD_BITS - 1) / TYPE_ID_WORD_BITS;
+    if(incidentTypeList->typeWords == 0)
+    {
+        incidentTypeList->typeWords = 1;
+    }
+}
+
+// find the type id of a type of incident by its short name, only needed when
+// a type is read in from or written to a file
+//	incidentTypeList	-- The incident type list
+//	typeOfIncident		-- The short name of the type of incident, ie; TF
+//	return			-- The type id, NO_TYPE_ID if there is no incidentType with the name
+int findIncidentTypeId(struct IncidentTypeList* incidentTypeList, const char* typeOfIncident)
+{
+    if(incidentTypeList->typeIdTable == NULL || typeOfIncident == NULL)
+    {
+        return NO_TYPE_ID;
+    }
+    return incidentTypeList->typeIdTable[findTypeIdSlot(incidentTypeList, typeOfIncident)];
+}
+
+// set the type bitset of a TypeOfIncidentList from the names in it. Names that are
+// not the type of any incidentType have no bit, "ALL" sets every bit.
+//	toil			-- The Type Of Incident List
+//	incidentTypeList	-- The incident type list that gives the type ids
+//	return			-- void
+void buildTypeOfIncidentBits(struct TypeOfIncidentList* toil, struct IncidentTypeList* incidentTypeList)
+{
+    free(toil->typeBits);
+    toil->typeBits = calloc(incidentTypeList->typeWords, sizeof(unsigned long long));
+    struct TypeOfIncident* toi = toil->head;
+    while(toi != NULL)
+    {
+        if(strcmp(toi->typeOfIncident, ALL) == 0)
+        {
+            int typeId;
+            for(typeId = 0; typeId < incidentTypeList->typeIdCount; typeId++)
+            {
+                toil->typeBits[typeId / TYPE_ID_WORD_BITS] |= 1ULL << (typeId % TYPE_ID_WORD_BITS);
+            }
+        }
+        else
+        {
+            int typeId = findIncidentTypeId(incidentTypeList, toi->typeOfIncident);
+            if(typeId != NO_TYPE_ID)
+            {
+                toil->typeBits[typeId / TYPE_ID_WORD_BITS] |= 1ULL << (typeId % TYPE_ID_WORD_BITS);
+            }
+        }
+        toi = toi->next;
+    }
+}
+
+// compile the processingFlags string of an incidentType so the flags are not searched
+// for in the string for every incident. Each flag character sets its bit in flags, the
+// flags that change an incident once it is parsed become its post parse steps and the
+// first of the TRVSMQFC flags it has picks the layout of its table in an email.
+//	incidentType	-- The incidentType, with processingFlags read in
+//	return		-- void
+void compileProcessingFlags(struct IncidentType* incidentType)
+{
+    const char* flag;
+    incidentType->flags = 0;
+    for(flag = incidentType->processingFlags; *flag != '\0'; flag++)
+    {
+        switch(*flag)
+        {
+            case 'S': incidentType->flags |= SERVER_NAME_SWITCH_BIT; break;
+            case 'C': incidentType->flags |= CRITICAL_INCIDENT_BIT; break;
+            case 'R': incidentType->flags |= REVENUE_HOUR_TIME_CHECK_BIT; break;
+            case 'T': incidentType->flags |= EXTENED_TABLE_BIT; break;
+            case 'M': incidentType->flags |= MISSION_CRITICAL_BIT; break;
+            case 'N': incidentType->flags |= GET_PREVIOUS_SERVER_BIT; break;
+            case 'V': incidentType->flags |= CHECK_TCS_VHLC_SERVER_BIT; break;
+            case 'F': incidentType->flags |= GET_CAR_NUMBER_BIT; break;
+            case 'O': incidentType->flags |= ONBOARD_INCIDENT_BIT; break;
+            case 'Q': incidentType->flags |= SERVER_RELATED_INCIDENT_BIT; break;
+            default: break;
+        }
+    }
+
+    //the previous server is found before the server names are switched
+    incidentType->postParseStepCount = 0;
+    if(incidentType->flags & GET_PREVIOUS_SERVER_BIT)
+    {
+        incidentType->postParseSteps[incidentType->postParseStepCount++] = POST_PARSE_PREVIOUS_SERVER;
+    }
+    if(incidentType->flags & SERVER_NAME_SWITCH_BIT)
+    {
+        incidentType->postParseSteps[incidentType->postParseStepCount++] = POST_PARSE_SERVER_NAME_SWITCH;
+    }
+    else if(incidentType->flags & SERVER_RELATED_INCIDENT_BIT)
+    {
+        incidentType->postParseSteps[incidentType->postParseStepCount++] = POST_PARSE_SERVER_LINE;
+    }
+
+    //Priority of flags is: TRVSMQFC -- based on incident types with colluding flags
+    if(incidentType->flags & EXTENED_TABLE_BIT)
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_EXTENDED;
+    }
+    else if(incidentType->flags & REVENUE_HOUR_TIME_CHECK_BIT)
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_REVENUE_HOURS;
+    }
+    else if(incidentType->flags & CHECK_TCS_VHLC_SERVER_BIT)
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_VHLC_CHANNEL;
+    }
+    else if(incidentType->flags & SERVER_NAME_SWITCH_BIT)
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_SERVER;
+    }
+    else if(incidentType->flags & MISSION_CRITICAL_BIT)
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_MISSION_CRITICAL;
+    }
+    else if(incidentType->flags & SERVER_RELATED_INCIDENT_BIT)
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_CONTROLLER;
+    }
+    else if(incidentType->flags & GET_CAR_NUMBER_BIT)
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_CAR_NUMBER;
+    }
+    else if(incidentType->flags & CRITICAL_INCIDENT_BIT)
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_CRITICAL;
+    }
+    else
+    {
+        incidentType->tableLayout = TABLE_LAYOUT_DEFAULT;
+    }
+}
+
+// run the post parse steps of an incidentType on an incident, in the order
+// compileProcessingFlags put them in
+//	incidentType	-- The type of the incident
+//	incident	-- The incident, with its fields parsed out of the log line
+//	subwayLine	-- The subway line of the log the incident was read from
+//	return		-- void
+void runPostParseSteps(const struct IncidentType* incidentType, struct Incident* incident, char* subwayLine)
+{
+    int step;
+    for(step = 0; step < incidentType->postParseStepCount; step++)
+    {
+        switch(incidentType->postParseSteps[step])
+        {
+            case POST_PARSE_PREVIOUS_SERVER:
+                //figure out the previous server the incident was on
+                getPrevServer(incident);
+                break;
+            case POST_PARSE_SERVER_NAME_SWITCH:
+                //copy subwayLine into location for the server incident
+                if(*incident->location == '\0')
+                {
+                    strcpy(incident->location,subwayLine);
+                }
+                //switches server names depending on the subwayLine
+                switchServerNames(incident,subwayLine);
+                break;
+            case POST_PARSE_SERVER_LINE:
+                strcpy(incident->other,subwayLine);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 // In the folder "Other/" the "Incident_Types.txt" config file exists with all the incident
 // types that the user wishes to look for. This function first checks the file by calling
 // the CSS_Tool_Validation_Program to check the file for validity, and if it passes the
 // check, it then reads in the entire file and saves the incidentTypes in the incident type list
+// The CSS_Tool_Validation_Program is built separately and is not part of this source,
+// see BUCKET_THRESHOLDS_ENABLED before giving thresholds a bucket size.
 //	incidentTypeList	-- The list in which all read incidentsTypes will be saved
 //	return			-- An int indicating success or failure
 int readInIncidentTypes(struct IncidentTypeList* incidentTypeList)
@@ -1615,10 +2640,13 @@ int readInIncidentTypes(struct IncidentTypeList* incidentTypeList)
                 incidentType->emailTemplate = (char*)calloc(STRING_LENGTH,sizeof(char));
                 incidentType->processingFlags = (char*)calloc(STRING_LENGTH,sizeof(char));
                 incidentType->keywordList = (struct KeywordList*)malloc(sizeof(struct KeywordList));
+                incidentType->typeId = NO_TYPE_ID;
                 incidentType->next = NULL;
 			        	incidentType->summaryTemplate = calloc(STRING_LENGTH,sizeof(char));
                 incidentType->thresholdList = (struct ThresholdList*)malloc(sizeof(struct ThresholdList));
                 incidentType->emailTemplateLocation = (char*)calloc(STRING_LENGTH,sizeof(char));
+                createKeywordList(incidentType->keywordList);
+                createThresholdList(incidentType->thresholdList);
                 
                 char* parseToolKeywords;
                 char* parseToolThresholds;
@@ -1659,6 +2687,10 @@ int readInIncidentTypes(struct IncidentTypeList* incidentTypeList)
                 //ie: CRITIAL TRAIN DETECTION FALIURE,LOCATION,TRACK ->
                 //are put into three different elements in the linked list
                 parseKeywords(incidentType,parseToolKeywords);
+                //compiles the keywords into the steps that copy the fields out of a line
+                incidentType->extractionPlan = createExtractionPlan(incidentType->keywordList);
+                //compiles the processing flags into the bitmask and steps they stand for
+                compileProcessingFlags(incidentType);
                 //parses the thresholds string and puts them into the linked list
                 parseThresholds(incidentType,parseToolThresholds);
                 
@@ -1689,6 +2721,16 @@ int readInIncidentTypes(struct IncidentTypeList* incidentTypeList)
         returnCode = ERROR;
     }
     
+    //every incidentType gets a type id, so the types are compared as numbers
+    assignIncidentTypeIds(incidentTypeList);
+
+    //now that every incidentType has been read in, build the matcher that
+    //looks for all of their keywords at once
+    if(returnCode == NO_ERROR)
+    {
+        incidentTypeList->keywordMatcher = createKeywordMatcher(incidentTypeList);
+    }
+    
     //free used memory and return
 	if(incidentTypeFile != NULL)
 	{
@@ -1761,11 +2803,18 @@ void deleteIncidentTypeList(struct IncidentTypeList* incidentTypeList)
 	//delete the lists (threshold and keyword)
         deleteThresholdList(incidentTypeListTraveller->thresholdList);
         deleteKeywordList(incidentTypeListTraveller->keywordList);
+        destroyExtractionPlan(incidentTypeListTraveller->extractionPlan);
 	//go to next incidentType
         incidentTypeListTraveller = incidentTypeListTraveller->next;
 	//free the incidentType pointer
         free(incidentType);
     }
+    if(incidentTypeList->keywordMatcher != NULL)
+    {
+        destroyKeywordMatcher(incidentTypeList->keywordMatcher);
+    }
+    free(incidentTypeList->byId);
+    free(incidentTypeList->typeIdTable);
     //free the threshold list pointer
     free(incidentTypeList);
     incidentTypeList = NULL;
@@ -1843,7 +2892,9 @@ int parseKeywords(struct IncidentType* incidentType, char* keywords)
     }
 }
 //parses the thresholds from a string, and saves them in a linked list that is then
-//stored in the incidentType struct.
+//stored in the incidentType struct. A threshold can have a third number, the size
+//in minutes of the buckets of time it is checked on ie [50,10080,60]. The bucket
+//size is ignored unless BUCKET_THRESHOLDS_ENABLED is TRUE
 //	incidentType	-- The incident type in which the thresholds will be stored
 //	thresholds	-- The string that contains all the thresholds
 int parseThresholds(struct IncidentType* incidentType, const char* thresholds)
@@ -1884,8 +2935,9 @@ int parseThresholds(struct IncidentType* incidentType, const char* thresholds)
             numHolderOffset = 0;
             //since that search ends with the pointer pointing to the comma, move 1 over
             parserOffset++;
-            //gets the second # (runs untill it sees a closing bracket)
-            while(parser != ']')
+            parser = *(thresholds + parserOffset);
+            //gets the second # (runs untill it sees a closing bracket or a comma)
+            while(parser != ']' && parser != COMMA_CHAR)
             {
 		//saves the character in numHolder
                 *(numHolder + numHolderOffset) = *(thresholds + parserOffset);
@@ -1893,11 +2945,37 @@ int parseThresholds(struct IncidentType* incidentType, const char* thresholds)
                 numHolderOffset++;
                 parser = *(thresholds + parserOffset);
             }
-	    //since the search ends with the pointer pointing to a closing bracket,
-	    //move to the next character
+	    //since the search ends with the pointer pointing to a closing bracket
+	    //or a comma, move to the next character
             parserOffset++;
 	    //get the # from the string
             threshold->numOfMinutes = atoi(numHolder);
+            threshold->bucketMinutes = 0;
+            //gets the optional third # (the bucket size), the search ended on its comma
+            if(parser == COMMA_CHAR)
+            {
+                free(numHolder);
+                numHolder = (char*)calloc(STRING_LENGTH,sizeof(char));
+                numHolderOffset = 0;
+                parser = *(thresholds + parserOffset);
+                while(parser != ']')
+                {
+                    *(numHolder + numHolderOffset) = *(thresholds + parserOffset);
+                    parserOffset++;
+                    numHolderOffset++;
+                    parser = *(thresholds + parserOffset);
+                }
+                parserOffset++;
+                if(BUCKET_THRESHOLDS_ENABLED)
+                {
+                    threshold->bucketMinutes = atoi(numHolder);
+                }
+                else
+                {
+                    printf("Bucket size %s of a threshold of %s is ignored, bucketed thresholds are not enabled\n",
+                      numHolder, incidentType->typeOfIncident);
+                }
+            }
 	    //add threshold to the list
             insertIntoThresholdList(incidentType->thresholdList,threshold);
             free(numHolder);
@@ -1906,13 +2984,19 @@ int parseThresholds(struct IncidentType* incidentType, const char* thresholds)
 }
 //a function that takes in an incidentType, and incident and a incident message line
 //from the log file, and reads in any keywords it needs to, as defined by
-//the incidentType.
+//the incidentType. line must start after the time, see parseTimestamp()
 //	incidentType	-- The incident type of the error message that is contained in line
 //	incident	-- The incident in which all parsed info will be stored
 //	line		-- The line to be parsed
 //	return		-- void
 void parseIncident(struct IncidentType* incidentType,struct Incident* incident,char* line)
 {
+    //copy every field in one pass over the line
+    if(incidentType->extractionPlan != NULL)
+    {
+        runExtractionPlan(incidentType->extractionPlan,incident,line);
+        return;
+    }
     //for some reson, the function that trims the first 4 useless characters 
     //doesnt work, it only trims 3... so maunal trimming
     //declare variables
@@ -1922,7 +3006,6 @@ void parseIncident(struct IncidentType* incidentType,struct Incident* incident,c
     //set initial variable states 
     current = incidentType->keywordList->head;
     next = current->next;
-    getDateFromString(line,&(incident->timeElement->timeObj));
     
     while(current != NULL)
     {
@@ -2071,31 +3154,12 @@ BOOL containsKeywords(struct IncidentType* incidentType,const char* msg)
 //	return		-- TRUE if the substring was found, FALSE otherwise
 BOOL contains(const char* string,const char* substring)
 {
-    BOOL found = FALSE;
-    int offset = 0;
-    //while the end of the string was not reached and the substring was not found
-    while(!found && *(string + offset) != '\0')
+    //an empty substring is never found
+    if(*substring == '\0')
     {
-	//if the characters are the same
-        if(*(string + offset) == *substring)
-        {
-            int i = 0;
-	    //while the characters are the same and the substring has not been found
-            while(*(string + offset + i) == *(substring + i) && !found)
-            {
-		i++;
-		//if the substring's next character is null
-                if(*(substring + i) == '\0')
-                {
-		    //the string has been found
-                    found = TRUE;
-                }
-            }
-        }
-        offset++;
+        return FALSE;
     }
-    
-    return found;
+    return findSubstring(string,substring) != NULL;
 }
 //given a line, the previous keyword, the next keyword, and a container,
 //this function will save the keyword between the prev and next keywords into
@@ -2301,46 +3365,38 @@ BOOL getSpecialKeyword(const char* line,const char* prev,const char* next,char*
 //			   are being looked for was found(TRUE) or not(FALSE)
 BOOL getIndexOfStr(const char* string,const char* substring,int* startIndex,int* endIndex)
 {
-    BOOL found = FALSE;
-    
-    int offset = 0;
-    
-    while(!found && *(string + offset) != '\0')
+    //an empty substring is never found
+    if(*substring == '\0')
     {
-        if(*(string + offset) == *substring)
-        {
-	    //if statment to deal with a space or no space:
-	    if(*(substring) == ' ')
-	    {
-            	*startIndex = offset;
-	    }
-	    else
-	    {
-		*startIndex = offset - 1;
-	    }
-            int i = 0;
-            while(*(string + offset + i) == *(substring + i) && !found)
-            {
-                if(*(substring + i + 1) == '\0')
-                {
-			//if statment to deal with a space or no space:
-	    		if(*(substring + i) == ' ')
-	    		{
-            			*endIndex = offset + i;
-	    		}
-	    		else
-	    		{
-				*endIndex = offset + i + 1;
-	   		}
-			found = TRUE;                
-		}
-                i++;
-            }
-        }
-        offset++;
+        return FALSE;
+    }
+    const char* match = findSubstring(string,substring);
+    if(match == NULL)
+    {
+        return FALSE;
     }
     
-    return found;
+    int offset = match - string;
+    int length = strlen(substring);
+    //if statment to deal with a space or no space:
+    if(*(substring) == ' ')
+    {
+        *startIndex = offset;
+    }
+    else
+    {
+        *startIndex = offset - 1;
+    }
+    //if statment to deal with a space or no space:
+    if(*(substring + length - 1) == ' ')
+    {
+        *endIndex = offset + length - 1;
+    }
+    else
+    {
+        *endIndex = offset + length;
+    }
+    return TRUE;
     
 }
 //fucntion that looks at server names and locations and switches them with
@@ -2467,14 +3523,24 @@ void switchServerNames(struct Incident* incident,char* subwayLine)
 	}	
 }
 
-
+// Check an incident against the temporary disabled incidents, which disable
+// some incident types at a location for a window of time
+//	dil	-- The list of temporary disabled incidents
+//	in	-- The incident being checked
+//	return	-- EMAILS_DISABLED if a disabled incident covers the incident, EMAILS_ENABLED otherwise
 int checkEnabledDisabled2(struct DisabledIncidentList* dil, struct Incident* in) {
+  // the index finds the windows at the incident's location without walking the list
+  if(dil->index != NULL) {
+    if(disabledIncidentIndexContains(dil->index, in->location, in->incidentType->typeId, in->timeElement->timeObj)) {
+      return EMAILS_DISABLED;
+    }
+    return EMAILS_ENABLED;
+  }
   struct DisabledIncident* din = dil->head;
   while(din != NULL) {
-    // locmatch will be used to see if in->location is geographically between 
-    // din->location1 and din->location2 in later releases, but for Rev 1.0
-	// this 'inbetween' functionality does not exist. Only a simple 1-1 check is done.
-    BOOL locMatch = strcmp(in->location, din->location1)==0;
+    // is in->location din->location1 or geographically between
+    // din->location1 and din->location2?
+    BOOL locMatch = disabledIncidentCoversLocation(dil, din, in->location);
     
 	// does the time of incident fall during the duration of this disablement?
     BOOL timeMatch = incidentDuringDurationWindow(in, din->duration) == WITHIN_DURATION;
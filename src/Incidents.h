@@ -3,6 +3,9 @@
 #include "DisabledIncidents.h"
 #include "StationPair.h"
 #include "EmailInfo.h"
+#include "KeywordMatcher.h"
+#include "ExtractionPlan.h"
+#include "TypeOfIncident.h"
 
 
 #define START_UP 600 // The tool has never run before, there are no previous
@@ -36,6 +39,17 @@
 #define EVENT_LINE 0
 #define LOCATION_LINE 1
 #define SUMMARY_LINE 2
+#define INCIDENT_ARENA_BLOCK_SIZE 65536 // bytes in each block of an IncidentArenaBlock chain
+#define INCIDENT_ARENA_ALIGNMENT 8 // allocations from an arena start on a multiple of this
+#define CAR_NUM_STRING_LENGTH 32 // length of the car number strings of a CCPair
+#define CC_MAPPING_DENSE_LIMIT 4096 // CC ids below this are looked up directly in an array
+#define NO_CAR_NUMBER -1 // the car number of a CC id that is not in CC_Mapping.txt
+#ifndef BUCKET_THRESHOLDS_ENABLED
+#define BUCKET_THRESHOLDS_ENABLED FALSE // thresholds with a bucket size ie [50,10080,60] are
+  // checked in buckets of time. Only set this to TRUE once the CSS_Tool_Validation_Program,
+  // which is not part of this source, accepts them in Incident_Types.txt, otherwise the
+  // file is rejected before it is read in
+#endif
 
 //used to tell addIncidentToLogs which character is currently being processed.
 #define TRAIN_STRING_LENGTH 20
@@ -77,6 +91,37 @@
 #define SERVER_RELATED_INCIDENT "Q" //character used in processing string to tell the 
 //program that the incident is server-based
 
+//the processing flags of an IncidentType are compiled into a bitmask when it is
+//read in, with one bit for each of the flag characters above
+#define SERVER_NAME_SWITCH_BIT 0x001
+#define CRITICAL_INCIDENT_BIT 0x002
+#define REVENUE_HOUR_TIME_CHECK_BIT 0x004
+#define EXTENED_TABLE_BIT 0x008
+#define MISSION_CRITICAL_BIT 0x010
+#define GET_PREVIOUS_SERVER_BIT 0x020
+#define CHECK_TCS_VHLC_SERVER_BIT 0x040
+#define GET_CAR_NUMBER_BIT 0x080
+#define ONBOARD_INCIDENT_BIT 0x100
+#define SERVER_RELATED_INCIDENT_BIT 0x200
+
+//the steps run on an incident once its fields are parsed out of a log line
+#define POST_PARSE_PREVIOUS_SERVER 0 //figure out the previous server from data
+#define POST_PARSE_SERVER_NAME_SWITCH 1 //save the subway line as the location and switch server names
+#define POST_PARSE_SERVER_LINE 2 //save the subway line in other
+#define MAX_POST_PARSE_STEPS 2 //at most two of the steps apply to an IncidentType
+
+//the layout of the table an IncidentType is shown in in an email, picked from
+//its processing flags in the order TRVSMQFC
+#define TABLE_LAYOUT_DEFAULT 0 //no processing flag picks a layout
+#define TABLE_LAYOUT_EXTENDED 1 //T
+#define TABLE_LAYOUT_REVENUE_HOURS 2 //R
+#define TABLE_LAYOUT_VHLC_CHANNEL 3 //V
+#define TABLE_LAYOUT_SERVER 4 //S
+#define TABLE_LAYOUT_MISSION_CRITICAL 5 //M
+#define TABLE_LAYOUT_CONTROLLER 6 //Q
+#define TABLE_LAYOUT_CAR_NUMBER 7 //F
+#define TABLE_LAYOUT_CRITICAL 8 //C
+
 #define PASSED " PASSED"
 #define TRAIN " TRAIN"
 #define LINE_NOT_FOUND 501 // A line was expected to be in this file but was
@@ -90,13 +135,23 @@
 #define NUM_OF_FOLDERS 6 // number of folder, currently six: TCS-A, TCS-B, 
   // TCS-2A, TCS-2B
   // atc/TCS-A, atc/TCS-B
-#define TEMP_FILE "_temp.log" // name of the temp file that is used to make a 
-  // copy of an existing WBSS file to avoid interfering with other programs
-  // operation
 
 #define FOLDER_NAME_LENGTH 8 // length of the char array used to hold the string
   // TCS-A, TCS-B, etc while creating file extensions
 #define DAYS_OF_WEEK 7
+#define MINUTES_IN_DAY 1440
+#define MINUTES_IN_WEEK 10080
+#define REVENUE_HOURS_WORD_BITS 32 // number of minutes held in each word of the RevenueHours table
+#define REVENUE_HOURS_DAYS_BEFORE 8 // days before the current time that the UTC offsets are found for
+#define REVENUE_HOURS_DAYS_AFTER 1 // days after the current time that the UTC offsets are found for
+#define MAX_UTC_OFFSETS 8 // most changes of UTC offset kept, ie; DST starting or ending
+#define EPOCH_WEEKDAY 4 // January 1 1970 was a Thursday
+#define DISABLED_TYPE 0 // every incident of a type is disabled
+#define DISABLED_TYPE_LOCATION 1 // incidents of a type at a location are disabled
+#define DISABLED_TYPE_DATA 2 // incidents of a type with some data are disabled
+#define DISABLED_TYPE_LOCATION_DATA 3 // incidents of a type at a location with some data are disabled
+#define DISABLED_KINDS 4 // number of ways an incident can be disabled
+#define DISABLED_INDEX_MIN_SIZE 16 // fewest slots in a DisabledIndex
 
 /*
 ** Structures
@@ -115,14 +170,132 @@ struct FilterTime {
 	BOOL timesExist;
 };
 
+// RevenueHours is the FilterTime array compiled into a table with one bit for
+// every minute of the week, so within_revenue_hours() can check the time of an
+// incident without converting it with localtime
+
+// minutes has a bit set for every minute of the week, starting at 00:00 Sunday,
+  // that is not in the filter times of its day
+// windowStart and windowEnd are the times the UTC offsets were found between
+// offsetCount is the number of UTC offsets in the window
+// offsetStart is the time each UTC offset starts at, the first is windowStart
+// offset is the seconds each UTC offset is ahead of UTC
+struct RevenueHours {
+	unsigned int minutes[MINUTES_IN_WEEK / REVENUE_HOURS_WORD_BITS];
+	time_t windowStart;
+	time_t windowEnd;
+	int offsetCount;
+	time_t offsetStart[MAX_UTC_OFFSETS];
+	long offset[MAX_UTC_OFFSETS];
+};
+
+// Checkpoint is a struct to hold the byte position within a log file at which
+// reading stopped, so the next run can seek straight back to it
+
+// device and inode identify the log file so a rotated file is not mistaken for it
+// fileSize is the size of the log file when it was last read, a smaller file
+  // means it was truncated
+// offset is the byte offset of the start of the last read line within the file
+// lineHash is a hash of the last read line, used to confirm the offset still
+  // points at it
+// exists is a flag for whether this object actually holds a checkpoint
+struct Checkpoint {
+  unsigned long device;
+  unsigned long inode;
+  long fileSize;
+  long offset;
+  unsigned long lineHash;
+  BOOL exists;
+};
+
+// LogReader is a struct for reading the lines of a log file straight out of
+// memory. The file from a starting offset onwards is read in with pread when it
+// is opened, and each line handed back is a pointer and length into that memory,
+// so nothing is copied per line
+
+// data is the contents of the log file from startOffset onwards, followed by a '\0'
+// size is the number of bytes in data, the size of the file when it was opened
+  // less startOffset
+// position is the offset in data of the next line to be read
+// startOffset is the byte offset in the log file of the start of data
+// fileSize is the size of the log file when it was opened
+// device and inode identify the log file that was opened
+// lineEnd is where the '\n' of the last line handed back was overwritten with
+  // '\0', NULL if there is no such line
+struct LogReader {
+  char* data;
+  size_t size;
+  size_t position;
+  long startOffset;
+  long fileSize;
+  unsigned long device;
+  unsigned long inode;
+  char* lineEnd;
+};
+
 // Record is a struct to hold info about the last file and line within the file 
 // that has been read in and parsed
 
 // fileName is the name of the last file that was read in
 // lastReadLine is the last line within the file, fileName, that was read in
+// checkpoint is the position of lastReadLine within the file, fileName
 struct Record {
   char* fileName;
   char* lastReadLine;
+  struct Checkpoint checkpoint;
+};
+
+// FolderReader is a struct to hold everything needed to read in one log folder
+// on its own thread, see readInFolder
+
+// logFolderPath is the path of the log folder, from LogFolderPaths.txt
+// subwayLine is the subway line of the log folder, ie; YUS
+// currentTime is the time up to which log files are read in
+// previousRecord is where reading stopped in this folder the last time
+// newRecord will hold where reading stopped in this folder this time
+// il will hold the incidents found in this folder
+// revenueHours, disabledList, disabledIncidentList, spl and incidentTypeList
+  // are shared by all FolderReaders and are only read from
+// keywordStats will hold the counts of the lines of this folder given to the
+  // KeywordMatcher of incidentTypeList
+struct FolderReader {
+  char* logFolderPath;
+  char* subwayLine;
+  time_t currentTime;
+  struct Record* previousRecord;
+  struct Record* newRecord;
+  struct IncidentList* il;
+  struct RevenueHours* revenueHours;
+  struct IncidentList* disabledList;
+  struct DisabledIncidentList* disabledIncidentList;
+  struct StationPairList* spl;
+  struct IncidentTypeList* incidentTypeList;
+  struct KeywordMatcherStats keywordStats;
+};
+
+// TypeProcessor is a struct shared by the threads that process the incident
+// types, see processTypesOfIncident. Each thread takes the next type id and
+// runs processInfo for every incidentType with it, in list order, since they
+// share a database file
+
+// incidentTypes is every incidentType, in the order of the IncidentTypeList
+// emailBuffers is the EmailBuffer of each incidentType, in the same order
+// typeCount is the number of incidentTypes
+// typeIdCount is the number of type ids
+// nextTypeId is the next type id to be taken by a thread
+// lock guards nextTypeId
+// incidentList, emailInfoList and ccMapping are shared by all threads and
+  // are only read from
+struct TypeProcessor {
+  struct IncidentType** incidentTypes;
+  struct EmailBuffer* emailBuffers;
+  int typeCount;
+  int typeIdCount;
+  int nextTypeId;
+  pthread_mutex_t lock;
+  struct IncidentList* incidentList;
+  struct EmailInfoList* emailInfoList;
+  struct CCMapping* ccMapping;
 };
 
 // a keyword is a word or phrase in an incidentType that is constant throughout
@@ -155,6 +328,16 @@ struct KeywordList
 // typeOfIncident is a string that identifies the type of incident 
 // emailTemplate is a string that formates what the email message will look like and say
 // thresholdList is a point to a struct that contains the list of thresholds for the IncidentType
+// extractionPlan is the keywordList compiled into the steps that copy the
+  // fields of an incident out of a line, NULL if it has not been compiled
+// typeId is a small number for typeOfIncident given when the IncidentTypeList is
+  // read in, types with the same typeOfIncident share it. NO_TYPE_ID for an
+  // IncidentType that is not in the list
+// flags is processingFlags compiled into a bitmask of the *_BIT values
+// postParseStepCount is the number of postParseSteps
+// postParseSteps is the POST_PARSE_* steps run on each incident of this type
+  // after it is parsed, in order
+// tableLayout is the TABLE_LAYOUT_* the incidents of this type are shown in
 // next is a pointer to the next IncidentType in the list
 struct IncidentType
 {
@@ -166,6 +349,12 @@ struct IncidentType
     char* summaryTemplate;
     char* processingFlags;
     struct ThresholdList* thresholdList;
+    struct ExtractionPlan* extractionPlan;
+    int typeId;
+    unsigned int flags;
+    int postParseStepCount;
+    int postParseSteps[MAX_POST_PARSE_STEPS];
+    int tableLayout;
     struct IncidentType* next;
 };
 
@@ -178,7 +367,8 @@ struct IncidentType
 // data is the track, signal or server name - The ID of the object
 // other is a potential field for certain incidents which need more fields to use
 // extra is a backup field in three fields are not enough
-// incidentType is a pointer to a struct that defines what type of incident it is
+// incidentType is a pointer to the IncidentType in the IncidentTypeList that
+  // defines what type of incident it is. It is not owned by the incident.
 // typeOfIncident is the type, CDF, CTDF, TF, etc
 // next is a pointer to the next Incident struct in the linked list.
 struct Incident {
@@ -194,11 +384,66 @@ struct Incident {
 };
 
 // A container for IncidentType linked lists.
+// keywordMatcher is built from the keywords of all the incident types once they
+// have been read in, it is NULL until then
+// typeIdCount is the number of type ids given out
+// byId is the first IncidentType with each type id
+// typeIdTable is a hash table of the typeOfIncident of byId, each slot holds a
+  // type id or NO_TYPE_ID
+// typeIdTableSize is the number of slots in typeIdTable, a power of two
+// typeWords is the number of words in a type bitset
 struct IncidentTypeList
 {
     struct IncidentType* head;
     struct IncidentType* tail;
     int count;
+    struct KeywordMatcher* keywordMatcher;
+    int typeIdCount;
+    struct IncidentType** byId;
+    int* typeIdTable;
+    int typeIdTableSize;
+    int typeWords;
+};
+
+// A block of memory that the incidents read in from the log files are
+// allocated from. Blocks are chained together and are only freed all at once.
+
+// size is the number of bytes in data
+// used is the number of bytes of data that have been handed out
+// next is the previous block in the chain
+// data is the memory of the block
+struct IncidentArenaBlock {
+	size_t size;
+	size_t used;
+	struct IncidentArenaBlock* next;
+	char data[];
+};
+
+// one disabled incident in a DisabledIndex
+
+// hash is the hash of the fields of din that are used by kind
+// kind is which fields of din are used, DISABLED_TYPE etc
+// din is the disabled incident, NULL if the slot is empty
+struct DisabledIndexEntry {
+	unsigned long hash;
+	int kind;
+	struct Incident* din;
+};
+
+// A hash table of the disabled incidents read in from Disabled_Incidents.txt.
+// Each disabled incident is keyed by its type and whichever of location and
+// data it has, so checking an incident takes one probe for each kind.
+
+// size is the number of slots, a power of two
+// count is the number of disabled incidents in the table
+// kindCount is the number of disabled incidents of each kind, a kind with none
+  // is not probed
+// entries is the slots of the table
+struct DisabledIndex {
+	int size;
+	int count;
+	int kindCount[DISABLED_KINDS];
+	struct DisabledIndexEntry* entries;
 };
 
 // container for Incident structs
@@ -206,10 +451,25 @@ struct IncidentTypeList
 // head is the first element
 // tail is the last element
 // count is the number of elements in the linked list
+// arena is the chain of blocks the incidents in the list were allocated from,
+  // NULL if every incident was allocated on its own with malloc (ie; the
+  // disabled incidents)
+// disabledIndex is the hash table of a list of disabled incidents, it is built
+  // by readInDisabledIncidents() and is NULL for any other list
+// typeIdCount is the number of type ids the list is partitioned by
+// typeStart is where the incidents of each type id start in byType, the
+  // incidents of type id t are byType[typeStart[t]] up to byType[typeStart[t+1]]
+// byType is every incident of the list grouped by type id, in list order within
+  // each type id. typeStart and byType are NULL until partitionIncidentList()
 struct IncidentList {
 	struct Incident* head;
 	struct Incident* tail;
 	int count;
+	struct IncidentArenaBlock* arena;
+	struct DisabledIndex* disabledIndex;
+	int typeIdCount;
+	int* typeStart;
+	struct Incident** byType;
 };
 
 struct HostnameLUT {
@@ -219,12 +479,36 @@ struct HostnameLUT {
     char* cyusHostname;
 };
 
+// carNumString is the car number as it is shown in an email table, TRx, RT-x/x or RT-x
+// carNumLabel is the car number as it is appended to an event line, x, RT-x/x or RT-x
 struct CCPair
 {
 	int cc;
 	int carNum;
+	char carNumString[CAR_NUM_STRING_LENGTH];
+	char carNumLabel[CAR_NUM_STRING_LENGTH];
 	struct CCPair *next;
 };
+
+// CC_Mapping.txt read into a table so the car number of a CC is found without
+// walking the CCPair list. CC ids are small numbers and are looked up directly
+// in an array, the few that are not are kept sorted and binary searched.
+
+// head is the linked list of every CCPair in the file, it owns them
+// denseSize is the number of CC ids in dense, every id from 0 up to the largest
+  // id below CC_MAPPING_DENSE_LIMIT
+// dense is the CCPair of each CC id below denseSize, the unmapped sentinel for
+  // an id that is not in the file
+// sparseCount is the number of CC ids that are not in dense
+// sparse is the CCPairs of the ids that are not in dense, sorted by CC id
+struct CCMapping
+{
+	struct CCPair* head;
+	int denseSize;
+	struct CCPair** dense;
+	int sparseCount;
+	struct CCPair** sparse;
+};
 /*
 ** Function Prototypes
 ** -----------------------------------------------------
@@ -237,6 +521,20 @@ void createIncidentList(struct IncidentList* il);
 
 void insertIntoIncidentList(struct IncidentList* il, struct Incident* in);
 
+// Move every incident in one list onto the tail of another list, in order
+void appendIncidentList(struct IncidentList* il, struct IncidentList* other);
+// group the incidents of a list by the type id of their incident type
+void partitionIncidentList(struct IncidentList* il, struct IncidentTypeList* incidentTypeList);
+// get the incidents of one type id from a partitioned list
+struct Incident** getIncidentsOfType(struct IncidentList* il, int typeId, int* count);
+
+// Allocate memory from the arena of an IncidentList, it is freed with the list
+void* allocateFromIncidentArena(struct IncidentList* il, size_t size);
+
+// Copy an incident that was parsed into scratch buffers into the arena of an
+// IncidentList and insert the copy at the tail of the list
+struct Incident* copyIncidentIntoList(struct IncidentList* il, struct Incident* in);
+
 // use for debuggin purpose and to present output to the user in a friendly way
 void printIncidentList(struct IncidentList* il, char* typeOfIncident);
 
@@ -253,22 +551,31 @@ int getCountOfIncidentList(struct IncidentList* il);
 // destroy the IncidentList object. 
 void destroyIncidentList(struct IncidentList* il);
 
-// lines read in from the logfiles are prefaced by 8 linux characters that are
+// Read a log file from an offset onwards into memory so its lines can be read
+// with readInLogLine
+BOOL openLogReader(struct LogReader* lr, char* filePath, long startOffset);
+
+// Free the memory held by a LogReader
+void closeLogReader(struct LogReader* lr);
+
+// lines read in from the logfiles are prefaced by some linux characters that are
 // not relevant to the info in the line. This method is design ONLY for reading
-// in lines from the log files as it automatically removes those 8 characters.
-int readInLineAndErase(FILE* fl, char** line, size_t size);
+// in lines from the log files as it automatically skips over those characters.
+int readInLogLine(struct LogReader* lr, char** line, size_t* length);
 
 // find matching error message and its macro shortcode
-BOOL containsErrorMessage(char* str, char* msg,struct IncidentTypeList* incidentTypeList,struct IncidentType** incidentType);
+BOOL containsErrorMessage(char* str, char* msg,struct IncidentTypeList* incidentTypeList,struct IncidentType** incidentType,
+  struct KeywordMatcherStats* keywordStats);
 
 // Reads in a CSS log file and adds relevant incidents to the IncidentList, il,
 // that is passed in. Depending on the value of preLastReadLine, the function
 // may skip some entries that have already been read in and processed.
-int readInLogFile(char* filePath, char* lastReadLine, struct IncidentList* il, 
-  char* newLastReadLine, struct FilterTime* filterTimes[7], 
+int readInLogFile(char* filePath, char* lastReadLine, struct Checkpoint* preCheckpoint,
+  struct IncidentList* il, char* newLastReadLine, struct Checkpoint* newCheckpoint,
+  struct RevenueHours* revenueHours,
   struct IncidentList* disabledList, struct DisabledIncidentList* disabledIncidentList,
   struct StationPairList* spl, char* subwayLine,
-  struct IncidentTypeList* incidentTypeList);
+  struct IncidentTypeList* incidentTypeList, struct KeywordMatcherStats* keywordStats);
 
 // function to read in ALL necessary log files. 
 // If code has ran previously and is in the middle of an hour then likely only 
@@ -279,6 +586,10 @@ int readInLogFile(char* filePath, char* lastReadLine, struct IncidentList* il,
 // of files will be handled.
 int readInFiles(struct IncidentList* il,struct IncidentTypeList* incidentTypeList);
 
+// read in all the log files in one log folder that have not been read in yet,
+// run on its own thread by readInFiles
+void* readInFolder(void* arg);
+
 // Read in file containing incidents that have been disabled due to frequency 
 // or non-safety related explanations. Incidents are stored in a linked-list
 // or Incident structs and are saved in the file "./Other/Disabled_Incidents"
@@ -288,6 +599,16 @@ void readInDisabledIncidents(struct IncidentList* il);
 // these times will be non-revenue hours during which faults and failures
 // are ignored because they are do to work and not passneger trains failing
 BOOL readInFilterTimes(struct FilterTime* ft[7]);
+
+// build the hash table of a list of disabled incidents
+struct DisabledIndex* createDisabledIndex(struct IncidentList* dil);
+
+// free the hash table of a list of disabled incidents
+void destroyDisabledIndex(struct DisabledIndex* index);
+
+// compile the filter times into a RevenueHours table, with the UTC offsets of
+// the days around currentTime
+void buildRevenueHours(struct RevenueHours* rh, struct FilterTime* ft[7], time_t currentTime);
 // Certain tracks sections or switches are considered to be in work yards from the point
 // of view WBSS. However, practically, they are on the mainline and revenue trains
 // use them daily.
@@ -301,16 +622,25 @@ BOOL reassignTrackCircuitLocations(struct Incident* in, struct StationPairList*
 // check to see if an incident occured during revenue hours or working hours 
 // if it was during working hours, then it is ignored.
 //	in	-- The incident being checked.
-//	ft	-- An array with the beginning and end of revenue hours for each day.
+//	rh	-- The table of revenue hours built from the filter times.
 //	return	-- FALSE if outside of revenue Hours, TRUE if within revenue hours (most incidents).
-BOOL within_revenue_hours(struct Incident* in, struct FilterTime* ft[7]);
+BOOL within_revenue_hours(struct Incident* in, struct RevenueHours* rh);
 
 // Read in ThresholdList and DatabaseList associated with this type of incident
 // and merge the new incidents that have been read in from the log files into
 // the databaseList. Check Threshold, disabled status and if this incident has 
 // been emailed about before and if these conditions are all met, prepare an
 // email to send.
-struct DatabaseList*  processInfo(char* typeOfIncident, struct IncidentList* incidentList, struct EmailInfoList* emailInfoList, struct SummaryEmailList* sel, struct IncidentType* incidentType, struct CCPair* ccPairLLHead);
+struct DatabaseList*  processInfo(char* typeOfIncident, struct IncidentList* incidentList, struct EmailInfoList* emailInfoList, struct EmailBuffer* emailBuffer, struct IncidentType* incidentType, struct CCMapping* ccMapping);
+
+// take type ids from a TypeProcessor until there are none left and process
+// the incidentTypes with each one, run on threads by processIncidentTypes
+void* processTypesOfIncident(void* arg);
+
+// run processInfo for every incidentType on a pool of threads and add what
+// each type wrote to the emails and the summary email list in list order
+void processIncidentTypes(struct IncidentTypeList* incidentTypeList, struct IncidentList* incidentList,
+  struct EmailInfoList* emailInfoList, struct SummaryEmailList* sel, struct CCMapping* ccMapping);
 
 //Sets the Incident Type List to it's default state
 void createIncidentTypeList(struct IncidentTypeList* incidentTypeList);
@@ -325,6 +655,15 @@ void printIncidentType(struct IncidentType* incidentType);
 //free all memory allocated for an IncidentTypeList and its memebers, and sets all
 //pointers to NULL
 void deleteIncidentTypeList(struct IncidentTypeList* incidentTypeList);
+// find the type id of a typeOfIncident, NO_TYPE_ID if it is not in the list
+int findIncidentTypeId(struct IncidentTypeList* incidentTypeList, const char* typeOfIncident);
+// set the type bitset of a TypeOfIncidentList from the type ids of its names
+void buildTypeOfIncidentBits(struct TypeOfIncidentList* toil, struct IncidentTypeList* incidentTypeList);
+// compile the processingFlags string of an incidentType into its flags, post parse steps
+// and table layout
+void compileProcessingFlags(struct IncidentType* incidentType);
+// run the post parse steps of an incidentType on an incident that was just parsed
+void runPostParseSteps(const struct IncidentType* incidentType, struct Incident* incident, char* subwayLine);
 //Sets all keywordList variables to their inital state
 void createKeywordList(struct KeywordList* keywordList);
 //adds a keyword to the end of a keywordList
@@ -360,6 +699,10 @@ void switchServerNames(struct Incident* incident,char* subwayLine);
 
 BOOL readInRecords(struct Record* recordsList[NUM_OF_FOLDERS]);
 
+// checks that a checkpoint still refers to the log file at filePath. A checkpoint
+// is no longer valid if the file was rotated (new device or inode) or truncated
+BOOL checkpointStillValid(struct Checkpoint* checkpoint, char* filePath);
+
 int checkEnabledDisabled2(struct DisabledIncidentList* dil, struct Incident* in);
 
 int incidentDuringDurationWindow(struct Incident* in, struct Duration* dur);
@@ -0,0 +1,399 @@
+#include "DatabaseRecord.h"
+#include "KeywordMatcher.h"
+
+/*------------------------------------------------------
+**
+** File: KeywordMatcher.c
+** Created: October 17, 2026
+**
+** Copyright �2015 Toronto Transit Commission
+**
+** Revision History
+**
+** 17 Oct 2026: Rev 5.1
+**                      - This file was introduced in this release
+**                      - containsErrorMessage() used to check every IncidentType's
+**                        keywords against a line one at a time, the KeywordMatcher
+**                        finds the keywords of all of them in one pass over the line
+**                      - added a prefilter on pairs of chars from the rarest keyword of each
+**                        incident type, lines without any of them are not scanned
+**                      - the counts of lines the prefilter was given and let through are kept by
+**                        each caller in a KeywordMatcherStats instead of in the shared KeywordMatcher
+**
+*/
+
+// how rare a char is expected to be in a CSS log line, used to pick the rarest
+// keyword of each IncidentType and the rarest pair of chars in it. Spaces,
+// digits, the time and date separators and the letters that make up most of
+// the TRAIN ... TRIGGERED and LOCATION ... INDICATION lines are common.
+//	ch	-- The char to be scored
+//	return	-- A higher number for a rarer char
+static int charRarity(unsigned char ch) {
+  if(ch == ' ' || isdigit(ch) || ch == ':' || ch == '/') {
+    return 1;
+  }
+  if(ch != '\0' && strchr("AEINORSTLCG", ch) != NULL) {
+    return 2;
+  }
+  return 4;
+}
+
+// set the bit for a pair of chars in the prefilter
+//	km	-- The KeywordMatcher being built
+//	first	-- The first char of the pair
+//	second	-- The second char of the pair
+//	return	-- void
+static void addBigramToFilter(struct KeywordMatcher* km, unsigned char first, unsigned char second) {
+  unsigned int bigram = ((unsigned int)first << 8) | second;
+  km->bigramFilter[bigram / BIGRAM_FILTER_WORD_BITS] |= 1u << (bigram % BIGRAM_FILTER_WORD_BITS);
+}
+
+// Build the prefilter. Every line that matches an IncidentType contains all of
+// its literal keywords, so it contains every pair of chars in them too. The
+// rarest pair of chars in the rarest keyword of each IncidentType is added.
+//	km	-- The KeywordMatcher being built
+//	return	-- void
+static void buildKeywordPrefilter(struct KeywordMatcher* km) {
+  int i, t;
+
+  memset(km->bigramFilter, 0, sizeof(km->bigramFilter));
+  km->prefilterEnabled = TRUE;
+
+  for(t = 0; t < km->typeCount; t++) {
+    struct Keyword* keyword;
+    struct Keyword* rarestKeyword = NULL;
+    int rarestScore = 0;
+
+    for(keyword = km->types[t]->keywordList->head; keyword != NULL; keyword = keyword->next) {
+      if(keyword->word[0] != '\\' && keyword->word[0] != '\0') {
+        int score = 0;
+        for(i = 0; keyword->word[i]; i++) {
+          score += charRarity((unsigned char)keyword->word[i]);
+        }
+        if(score > rarestScore) {
+          rarestScore = score;
+          rarestKeyword = keyword;
+        }
+      }
+    }
+
+    // this type matches any line, so no line can be rejected
+    if(rarestKeyword == NULL) {
+      printf("Keyword prefilter is disabled, incident type %s has no literal keywords\n", km->types[t]->typeOfIncident);
+      km->prefilterEnabled = FALSE;
+      return;
+    }
+
+    const unsigned char* word = (const unsigned char*)rarestKeyword->word;
+    if(word[1] == '\0') {
+      // a one char keyword can be followed by anything, even the end of the line
+      for(i = 0; i < 256; i++) {
+        addBigramToFilter(km, word[0], (unsigned char)i);
+      }
+    }
+    else {
+      int rarestPair = 0;
+      int rarestPairScore = 0;
+      for(i = 0; word[i + 1]; i++) {
+        int score = charRarity(word[i]) + charRarity(word[i + 1]);
+        if(score > rarestPairScore) {
+          rarestPairScore = score;
+          rarestPair = i;
+        }
+      }
+      addBigramToFilter(km, word[rarestPair], word[rarestPair + 1]);
+    }
+  }
+}
+
+// make room in a KeywordMatcher for one more state
+//	km		-- The KeywordMatcher being built
+//	capacity	-- The number of states there is room for, updated if it grows
+//	return		-- The new state, with no transitions and no keyword
+static int addKeywordMatcherState(struct KeywordMatcher* km, int* capacity) {
+  int i;
+  int state = km->stateCount;
+
+  if(km->stateCount == *capacity) {
+    *capacity *= 2;
+    km->transitions = (int*)realloc(km->transitions, (*capacity) * km->classCount * sizeof(int));
+    km->keywordAtState = (int*)realloc(km->keywordAtState, (*capacity) * sizeof(int));
+  }
+  for(i = 0; i < km->classCount; i++) {
+    km->transitions[state*km->classCount + i] = NO_KEYWORD;
+  }
+  km->keywordAtState[state] = NO_KEYWORD;
+  km->stateCount++;
+  return state;
+}
+
+// Build a KeywordMatcher from the keywords of every IncidentType in the list.
+// Special keywords (\K, \L, \E, \X) are only used to find where the data is
+// in the line, so only the literal keywords are added to it.
+//	incidentTypeList	-- The list of all incident types the program read in
+//	return			-- The allocated KeywordMatcher
+struct KeywordMatcher* createKeywordMatcher(struct IncidentTypeList* incidentTypeList) {
+  struct KeywordMatcher* km = (struct KeywordMatcher*)malloc(sizeof(struct KeywordMatcher));
+  struct IncidentType* incidentType;
+  struct Keyword* keyword;
+  const unsigned char* ch;
+  int i, j, t;
+
+  // give every char that appears in a keyword its own class, so each state
+  // only needs a transition for those chars and one for everything else
+  memset(km->charClass, 0, sizeof(km->charClass));
+  km->classCount = 1;
+  km->typeCount = 0;
+  for(incidentType = incidentTypeList->head; incidentType != NULL; incidentType = incidentType->next) {
+    for(keyword = incidentType->keywordList->head; keyword != NULL; keyword = keyword->next) {
+      if(keyword->word[0] != '\\') {
+        for(ch = (const unsigned char*)keyword->word; *ch; ch++) {
+          if(km->charClass[*ch] == 0) {
+            km->charClass[*ch] = (unsigned char)km->classCount;
+            km->classCount++;
+          }
+        }
+      }
+    }
+    km->typeCount++;
+  }
+
+  km->types = (struct IncidentType**)malloc((km->typeCount + 1) * sizeof(struct IncidentType*));
+  km->typeKeywordCount = (int*)calloc(km->typeCount + 1, sizeof(int));
+
+  // build a trie of all the literal keywords, starting with just the root
+  int capacity = 64;
+  km->stateCount = 0;
+  km->keywordCount = 0;
+  km->transitions = (int*)malloc(capacity * km->classCount * sizeof(int));
+  km->keywordAtState = (int*)malloc(capacity * sizeof(int));
+  addKeywordMatcherState(km, &capacity);
+
+  // every (keyword, incidentType) pair, used to build keywordTypes
+  int pairCapacity = 64;
+  int pairCount = 0;
+  int* pairKeyword = (int*)malloc(pairCapacity * sizeof(int));
+  int* pairType = (int*)malloc(pairCapacity * sizeof(int));
+
+  t = 0;
+  for(incidentType = incidentTypeList->head; incidentType != NULL; incidentType = incidentType->next) {
+    int typePairStart = pairCount;
+    km->types[t] = incidentType;
+
+    for(keyword = incidentType->keywordList->head; keyword != NULL; keyword = keyword->next) {
+      if(keyword->word[0] == '\\' || keyword->word[0] == '\0') {
+        continue;
+      }
+      // follow the trie down the keyword, adding states where needed
+      int state = KEYWORD_MATCHER_ROOT;
+      for(ch = (const unsigned char*)keyword->word; *ch; ch++) {
+        int next = km->transitions[state*km->classCount + km->charClass[*ch]];
+        if(next == NO_KEYWORD) {
+          next = addKeywordMatcherState(km, &capacity);
+          km->transitions[state*km->classCount + km->charClass[*ch]] = next;
+        }
+        state = next;
+      }
+      // the same keyword used by several types is only added once
+      if(km->keywordAtState[state] == NO_KEYWORD) {
+        km->keywordAtState[state] = km->keywordCount;
+        km->keywordCount++;
+      }
+
+      // a keyword written twice for one type only needs to be found once
+      BOOL duplicate = FALSE;
+      for(j = typePairStart; j < pairCount; j++) {
+        if(pairKeyword[j] == km->keywordAtState[state]) {
+          duplicate = TRUE;
+        }
+      }
+      if(duplicate == FALSE) {
+        if(pairCount == pairCapacity) {
+          pairCapacity *= 2;
+          pairKeyword = (int*)realloc(pairKeyword, pairCapacity * sizeof(int));
+          pairType = (int*)realloc(pairType, pairCapacity * sizeof(int));
+        }
+        pairKeyword[pairCount] = km->keywordAtState[state];
+        pairType[pairCount] = t;
+        pairCount++;
+        km->typeKeywordCount[t]++;
+      }
+    }
+    t++;
+  }
+
+  // Breadth first, set the failure state of every state (the longest suffix of
+  // it that is also in the trie) and fill in every missing transition, so that
+  // matching never has to follow failure states.
+  int* failure = (int*)malloc(km->stateCount * sizeof(int));
+  int* queue = (int*)malloc(km->stateCount * sizeof(int));
+  int queueHead = 0;
+  int queueTail = 0;
+  km->outputLink = (int*)malloc(km->stateCount * sizeof(int));
+
+  failure[KEYWORD_MATCHER_ROOT] = KEYWORD_MATCHER_ROOT;
+  km->outputLink[KEYWORD_MATCHER_ROOT] = NO_KEYWORD;
+  for(i = 0; i < km->classCount; i++) {
+    int child = km->transitions[KEYWORD_MATCHER_ROOT*km->classCount + i];
+    if(child == NO_KEYWORD) {
+      km->transitions[KEYWORD_MATCHER_ROOT*km->classCount + i] = KEYWORD_MATCHER_ROOT;
+    }
+    else {
+      failure[child] = KEYWORD_MATCHER_ROOT;
+      km->outputLink[child] = NO_KEYWORD;
+      queue[queueTail++] = child;
+    }
+  }
+  while(queueHead < queueTail) {
+    int state = queue[queueHead++];
+    for(i = 0; i < km->classCount; i++) {
+      int child = km->transitions[state*km->classCount + i];
+      int fallback = km->transitions[failure[state]*km->classCount + i];
+      if(child == NO_KEYWORD) {
+        km->transitions[state*km->classCount + i] = fallback;
+      }
+      else {
+        failure[child] = fallback;
+        km->outputLink[child] = km->keywordAtState[fallback] != NO_KEYWORD ? fallback : km->outputLink[fallback];
+        queue[queueTail++] = child;
+      }
+    }
+  }
+
+  // group the incident types by the keyword they need
+  km->keywordTypeStart = (int*)calloc(km->keywordCount + 1, sizeof(int));
+  km->keywordTypes = (int*)malloc((pairCount + 1) * sizeof(int));
+  for(j = 0; j < pairCount; j++) {
+    km->keywordTypeStart[pairKeyword[j] + 1]++;
+  }
+  for(i = 0; i < km->keywordCount; i++) {
+    km->keywordTypeStart[i + 1] += km->keywordTypeStart[i];
+  }
+  int* cursor = (int*)malloc((km->keywordCount + 1) * sizeof(int));
+  memcpy(cursor, km->keywordTypeStart, (km->keywordCount + 1) * sizeof(int));
+  for(j = 0; j < pairCount; j++) {
+    km->keywordTypes[cursor[pairKeyword[j]]++] = pairType[j];
+  }
+
+  buildKeywordPrefilter(km);
+
+  printf("Keyword matcher built with %d keywords for %d incident types\n", km->keywordCount, km->typeCount);
+
+  free(cursor);
+  free(failure);
+  free(queue);
+  free(pairKeyword);
+  free(pairType);
+  return km;
+}
+
+// Free a KeywordMatcher and everything it holds
+//	km	-- The KeywordMatcher to be destroyed
+//	return	-- void
+void destroyKeywordMatcher(struct KeywordMatcher* km) {
+  free(km->transitions);
+  free(km->keywordAtState);
+  free(km->outputLink);
+  free(km->keywordTypeStart);
+  free(km->keywordTypes);
+  free(km->types);
+  free(km->typeKeywordCount);
+  free(km);
+}
+
+// Check a line against the prefilter. This is a single pass over the line
+// looking each pair of chars up in the bigramFilter bitmap.
+//	km	-- The KeywordMatcher built from the incident type list
+//	msg	-- The string read in from the log file
+//	return	-- FALSE if the line cannot match any IncidentType, TRUE if it might
+BOOL keywordPrefilterPasses(struct KeywordMatcher* km, const char* msg) {
+  const unsigned char* ch;
+
+  if(km->prefilterEnabled == FALSE) {
+    return TRUE;
+  }
+  // the pair made by the last char and the '\0' is checked too, for one char keywords
+  for(ch = (const unsigned char*)msg; *ch; ch++) {
+    unsigned int bigram = ((unsigned int)ch[0] << 8) | ch[1];
+    if(km->bigramFilter[bigram / BIGRAM_FILTER_WORD_BITS] & (1u << (bigram % BIGRAM_FILTER_WORD_BITS))) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+// print how many lines the prefilter let through, to show how selective the
+// keywords in Incident_Types.txt are
+//	km	-- The KeywordMatcher built from the incident type list
+//	stats	-- The counts of every thread that used km, added up
+//	return	-- void
+void printKeywordMatcherStats(struct KeywordMatcher* km, struct KeywordMatcherStats* stats) {
+  unsigned long checked = stats->linesChecked;
+  unsigned long passed = stats->linesPassed;
+
+  if(km->prefilterEnabled == FALSE) {
+    printf("Keyword prefilter is disabled, all %lu lines were scanned for keywords\n", checked);
+  }
+  else if(checked > 0) {
+    printf("Keyword prefilter let through %lu of %lu lines (%.1f%%)\n", passed, checked, 100.0 * passed / checked);
+  }
+  else {
+    printf("Keyword prefilter has not checked any lines\n");
+  }
+}
+
+// Scan a line once and return the first IncidentType, in IncidentTypeList order,
+// whose literal keywords are all in the line. An IncidentType with only special
+// keywords matches any line that is not empty, the same as containsKeywords().
+// Only local arrays and the caller's stats are written to so this can be called
+// from any thread.
+//	km	-- The KeywordMatcher built from the incident type list
+//	msg	-- The string read in from the log file
+//	stats	-- The counts of the calling thread, the line is counted in them
+//	return	-- The matching IncidentType, NULL if there is none
+struct IncidentType* matchKeywords(struct KeywordMatcher* km, const char* msg, struct KeywordMatcherStats* stats) {
+  if(msg == NULL || *msg == '\0') {
+    return NULL;
+  }
+
+  // most lines do not match anything and are rejected here
+  stats->linesChecked++;
+  if(keywordPrefilterPasses(km, msg) == FALSE) {
+    return NULL;
+  }
+  stats->linesPassed++;
+
+  // seen marks the keywords that have been found in the line, found counts
+  // how many of each incident type's keywords have been found
+  BOOL seen[km->keywordCount + 1];
+  int found[km->typeCount + 1];
+  memset(seen, 0, sizeof(seen));
+  memset(found, 0, sizeof(found));
+
+  int state = KEYWORD_MATCHER_ROOT;
+  const unsigned char* ch;
+  int i;
+  for(ch = (const unsigned char*)msg; *ch; ch++) {
+    state = km->transitions[state*km->classCount + km->charClass[*ch]];
+
+    // every keyword that ends at this char
+    int output = km->keywordAtState[state] != NO_KEYWORD ? state : km->outputLink[state];
+    while(output != NO_KEYWORD) {
+      int keyword = km->keywordAtState[output];
+      if(seen[keyword] == FALSE) {
+        seen[keyword] = TRUE;
+        for(i = km->keywordTypeStart[keyword]; i < km->keywordTypeStart[keyword + 1]; i++) {
+          found[km->keywordTypes[i]]++;
+        }
+      }
+      output = km->outputLink[output];
+    }
+  }
+
+  for(i = 0; i < km->typeCount; i++) {
+    if(found[i] == km->typeKeywordCount[i]) {
+      return km->types[i];
+    }
+  }
+  return NULL;
+}
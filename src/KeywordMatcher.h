@@ -0,0 +1,93 @@
+#ifndef KEYWORDMATCHER_H
+#define KEYWORDMATCHER_H
+#include "StringAndFileMethods.h"
+
+#define KEYWORD_MATCHER_ROOT 0 // the state the matcher starts every line in
+#define NO_KEYWORD -1 // a state that is not the end of any keyword
+#define BIGRAM_COUNT 65536 // number of different pairs of chars
+#define BIGRAM_FILTER_WORD_BITS 32 // number of bigrams held in each word of the filter
+
+struct IncidentType;
+struct IncidentTypeList;
+
+/*
+** Structures
+** -----------------------------------------------------
+*/
+
+// KeywordMatcher is an Aho-Corasick automaton built from the literal (not
+// special, ie; \K) keywords of every IncidentType. A log line is scanned once,
+// one state change per character, and every keyword found in it is marked off
+// against the IncidentTypes that need it.
+
+// stateCount is the number of states in the automaton
+// classCount is the number of character classes, every char that appears in a
+  // keyword has its own class and all other chars share class 0
+// charClass is the class of each char
+// transitions is the next state for every state and class,
+  // transitions[state*classCount + class]
+// keywordAtState is the keyword that ends at each state, NO_KEYWORD if none
+// outputLink is the next state along the failure chain of each state that is
+  // the end of a keyword, NO_KEYWORD if there is none. Following it finds every
+  // keyword that ends at the current char.
+// keywordCount is the number of distinct literal keywords
+// keywordTypeStart and keywordTypes hold the IncidentTypes that need each
+  // keyword, they are keywordTypes[keywordTypeStart[k]] up to
+  // keywordTypes[keywordTypeStart[k+1]] for keyword k
+// typeCount is the number of IncidentTypes
+// types is every IncidentType in the same order as the IncidentTypeList
+// typeKeywordCount is the number of distinct literal keywords each IncidentType needs
+// prefilterEnabled is a flag for whether lines can be rejected by the prefilter,
+  // it is FALSE if an IncidentType has no literal keywords and so matches any line
+// bigramFilter has a bit set for the rarest pair of chars in the rarest keyword
+  // of each IncidentType. A line without any of these pairs cannot match any
+  // IncidentType and is rejected before being scanned by the automaton.
+struct KeywordMatcher {
+  int stateCount;
+  int classCount;
+  unsigned char charClass[256];
+  int* transitions;
+  int* keywordAtState;
+  int* outputLink;
+  int keywordCount;
+  int* keywordTypeStart;
+  int* keywordTypes;
+  int typeCount;
+  struct IncidentType** types;
+  int* typeKeywordCount;
+  BOOL prefilterEnabled;
+  unsigned int bigramFilter[BIGRAM_COUNT / BIGRAM_FILTER_WORD_BITS];
+};
+
+// counts of the lines a KeywordMatcher was given, kept by each thread that
+// reads log lines and added up once they are done
+
+// linesChecked is the number of lines given to the prefilter
+// linesPassed is the number of lines it let through
+struct KeywordMatcherStats {
+  unsigned long linesChecked;
+  unsigned long linesPassed;
+};
+
+/*
+** Function Prototypes
+** -----------------------------------------------------
+*/
+
+// Build a KeywordMatcher from the keywords of every IncidentType in the list
+struct KeywordMatcher* createKeywordMatcher(struct IncidentTypeList* incidentTypeList);
+
+// Free a KeywordMatcher and everything it holds
+void destroyKeywordMatcher(struct KeywordMatcher* km);
+
+// Check a line against the prefilter, FALSE if it cannot match any IncidentType
+BOOL keywordPrefilterPasses(struct KeywordMatcher* km, const char* msg);
+
+// print how many lines the prefilter let through
+void printKeywordMatcherStats(struct KeywordMatcher* km, struct KeywordMatcherStats* stats);
+
+// Scan a line once and return the first IncidentType, in IncidentTypeList order,
+// whose literal keywords are all in the line. NULL if there is none.
+struct IncidentType* matchKeywords(struct KeywordMatcher* km, const char* msg, struct KeywordMatcherStats* stats);
+
+#endif
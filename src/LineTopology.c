@@ -0,0 +1,229 @@
+#include "LineTopology.h"
+
+/*------------------------------------------------------
+**
+** File: LineTopology.c
+** Created: October 17, 2026
+**
+** Copyright �2015 Toronto Transit Commission
+**
+** Revision History
+**
+** 17 Oct 2026: Rev 5.1
+**                      - This file was introduced in this release
+**                      - location2 of a temporary disabled incident was meant to disable every
+**                        location between location1 and location2 but only location1 was
+**                        checked. The order of the locations along each line is read in so a
+**                        range of locations can be disabled
+**
+*/
+
+// find the slot of a location name in the hash table of stops, either the
+// slot holding its first stop or the empty slot it would go in
+//	lt		-- The LineTopology
+//	location	-- The location name to find
+//	return		-- The slot
+static int findStopSlot(struct LineTopology* lt, const char* location) {
+  int slot = hashString(location) & (lt->tableSize - 1);
+  while(lt->stopTable[slot] != NO_STOP && strcmp(lt->stopNames[lt->stopTable[slot]], location) != 0) {
+    slot = (slot + 1) & (lt->tableSize - 1);
+  }
+  return slot;
+}
+
+// find the index of a line by name, adding it if it is not already there
+//	lt		-- The LineTopology
+//	lineName	-- The name of the line
+//	return		-- The index of the line in lineNames
+static int addLine(struct LineTopology* lt, const char* lineName) {
+  int l;
+  for(l = 0; l < lt->lineCount; l++) {
+    if(strcmp(lt->lineNames[l], lineName) == 0) {
+      return l;
+    }
+  }
+  lt->lineNames = realloc(lt->lineNames, (lt->lineCount + 1)*sizeof(char*));
+  lt->lineNames[lt->lineCount] = (char*)calloc(strlen(lineName) + 1, sizeof(char));
+  strcpy(lt->lineNames[lt->lineCount], lineName);
+  lt->lineCount++;
+  return lt->lineCount - 1;
+}
+
+// number the stops of each line along it and put them in the hash table. A
+// location on more than one line has its stops chained by nextStop.
+//	lt	-- The LineTopology, with every stop read in
+//	return	-- void
+static void indexLineTopology(struct LineTopology* lt) {
+  int* stopsOnLine = calloc(lt->lineCount + 1, sizeof(int));
+  int s;
+  for(s = 0; s < lt->stopCount; s++) {
+    lt->stopOrdinal[s] = stopsOnLine[lt->stopLine[s]]++;
+  }
+  free(stopsOnLine);
+
+  while(lt->tableSize < 2*lt->stopCount) {
+    lt->tableSize *= 2;
+  }
+  lt->stopTable = malloc(lt->tableSize*sizeof(int));
+  for(s = 0; s < lt->tableSize; s++) {
+    lt->stopTable[s] = NO_STOP;
+  }
+  // added from the last stop back so each chain is in file order
+  for(s = lt->stopCount - 1; s >= 0; s--) {
+    int slot = findStopSlot(lt, lt->stopNames[s]);
+    lt->nextStop[s] = lt->stopTable[slot];
+    lt->stopTable[slot] = s;
+  }
+}
+
+// 'readInLineTopology' reads in a .txt file with the stations and
+// interlockings of each line in the order they are along the line. Each row
+// is the name of the line followed by its locations, separated by semi colons.
+// The locations are the WBSS names that incidents are logged with. A long line
+// can be split over several rows, each row carries on from the one before it.
+// E.g.
+// "YUS;Finch;North York Centre;Sheppard-Yonge;York Mills"
+// "YUS;Lawrence;Eglinton"
+//	return	-- The LineTopology, NULL if the file could not be found
+struct LineTopology* readInLineTopology(void) {
+  char* filePath = (char*)calloc(STRING_LENGTH, sizeof(char));
+  constructLocalFilepath(filePath, OTHER, LINE_TOPOLOGY, DOT_TXT);
+  FILE* fp = fopen(filePath, "r");
+
+  if(fp == NULL) {
+    printf("The file: '%s' could not be found. Ranges of locations cannot be disabled, only their first location will be\n", filePath);
+    free(filePath);
+    return NULL;
+  }
+
+  struct LineTopology* lt = malloc(sizeof(struct LineTopology));
+  lt->lineCount = 0;
+  lt->lineNames = NULL;
+  lt->stopCount = 0;
+  lt->stopNames = NULL;
+  lt->stopLine = NULL;
+  lt->stopOrdinal = NULL;
+  lt->nextStop = NULL;
+  lt->stopTable = NULL;
+  lt->tableSize = 16;
+  int stopCapacity = 0;
+
+  // tmp is a variable used to hold the lines as they are read in and parsed
+  char* tmp = (char*)calloc(STRING_LENGTH, sizeof(char));
+  int lineRes = readInLine(fp, &tmp, STRING_LENGTH);
+
+  while(lineRes != END_OF_FILE) {
+    if(lineRes == READ_IN_STRING || lineRes == STRANGE_END_OF_FILE) {
+      // the first field is the line, the rest are its locations in order
+      char* token = strtok(tmp, ";");
+      int line = token != NULL ? addLine(lt, token) : 0;
+      token = token != NULL ? strtok(NULL, ";") : NULL;
+      while(token != NULL) {
+        if(lt->stopCount == stopCapacity) {
+          stopCapacity = stopCapacity == 0 ? 64 : stopCapacity*2;
+          lt->stopNames = realloc(lt->stopNames, stopCapacity*sizeof(char*));
+          lt->stopLine = realloc(lt->stopLine, stopCapacity*sizeof(int));
+          lt->stopOrdinal = realloc(lt->stopOrdinal, stopCapacity*sizeof(int));
+          lt->nextStop = realloc(lt->nextStop, stopCapacity*sizeof(int));
+        }
+        lt->stopNames[lt->stopCount] = (char*)calloc(strlen(token) + 1, sizeof(char));
+        strcpy(lt->stopNames[lt->stopCount], token);
+        lt->stopLine[lt->stopCount] = line;
+        lt->stopCount++;
+        token = strtok(NULL, ";");
+      }
+    }
+    // reallocate the variable tmp to be STRING_LENGTH long.
+    tmp = (char*)realloc(tmp, STRING_LENGTH);
+    // read in the next line
+    lineRes = readInLine(fp, &tmp, STRING_LENGTH);
+  }
+
+  if(EOF == fclose(fp)) {
+    printf("Could not close file |%s|.\n", filePath);
+    printf("errno = %d, strerror is %s\n", errno, strerror(errno));
+  }
+
+  indexLineTopology(lt);
+  printf("Line topology: %d locations on %d lines\n", lt->stopCount, lt->lineCount);
+
+  //clean things up
+  free(tmp);
+  free(filePath);
+  return lt;
+}
+
+// Free a LineTopology and everything it holds
+//	lt	-- The LineTopology to free
+//	return	-- void
+void destroyLineTopology(struct LineTopology* lt) {
+  if(lt == NULL) {
+    return;
+  }
+  int i;
+  for(i = 0; i < lt->lineCount; i++) {
+    free(lt->lineNames[i]);
+  }
+  for(i = 0; i < lt->stopCount; i++) {
+    free(lt->stopNames[i]);
+  }
+  free(lt->lineNames);
+  free(lt->stopNames);
+  free(lt->stopLine);
+  free(lt->stopOrdinal);
+  free(lt->nextStop);
+  free(lt->stopTable);
+  free(lt);
+}
+
+// Find the first stop of a location, the others follow it along nextStop
+//	lt		-- The LineTopology
+//	location	-- The location name
+//	return		-- The index of the stop, NO_STOP if the location is not on any line
+int findLineTopologyStop(struct LineTopology* lt, const char* location) {
+  return lt->stopTable[findStopSlot(lt, location)];
+}
+
+// Find a line that both ends of a range of locations are on. The ordinals are
+// put in order, so the range can be entered from either end.
+//	lt		-- The LineTopology
+//	location1	-- One end of the range
+//	location2	-- The other end of the range
+//	line		-- Set to the line both ends are on
+//	firstOrdinal	-- Set to the lower ordinal of the two ends
+//	lastOrdinal	-- Set to the higher ordinal of the two ends
+//	return		-- TRUE if a line was found, FALSE otherwise
+BOOL resolveLineRange(struct LineTopology* lt, const char* location1, const char* location2,
+  int* line, int* firstOrdinal, int* lastOrdinal) {
+  int s1;
+  for(s1 = findLineTopologyStop(lt, location1); s1 != NO_STOP; s1 = lt->nextStop[s1]) {
+    int s2;
+    for(s2 = findLineTopologyStop(lt, location2); s2 != NO_STOP; s2 = lt->nextStop[s2]) {
+      if(lt->stopLine[s1] == lt->stopLine[s2]) {
+        *line = lt->stopLine[s1];
+        *firstOrdinal = lt->stopOrdinal[s1] < lt->stopOrdinal[s2] ? lt->stopOrdinal[s1] : lt->stopOrdinal[s2];
+        *lastOrdinal = lt->stopOrdinal[s1] < lt->stopOrdinal[s2] ? lt->stopOrdinal[s2] : lt->stopOrdinal[s1];
+        return TRUE;
+      }
+    }
+  }
+  return FALSE;
+}
+
+// Check if a location is on a line between two ordinals, the ends included
+//	lt		-- The LineTopology
+//	location	-- The location name
+//	line		-- The line
+//	firstOrdinal	-- The lower ordinal of the range
+//	lastOrdinal	-- The higher ordinal of the range
+//	return		-- TRUE if the location is in the range, FALSE otherwise
+BOOL lineTopologyStopInRange(struct LineTopology* lt, const char* location, int line,
+  int firstOrdinal, int lastOrdinal) {
+  int s;
+  for(s = findLineTopologyStop(lt, location); s != NO_STOP; s = lt->nextStop[s]) {
+    if(lt->stopLine[s] == line && lt->stopOrdinal[s] >= firstOrdinal && lt->stopOrdinal[s] <= lastOrdinal) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
@@ -0,0 +1,66 @@
+#ifndef LINETOPOLOGY_H
+#define LINETOPOLOGY_H
+#include "StringAndFileMethods.h"
+
+#define LINE_TOPOLOGY "Line_Topology" // name of the file that holds the order of
+  // the stations and interlockings along each line
+#define LOCATION_RANGE_SEPARATOR ".." // separates the two ends of a range of
+  // locations in the temporary disabled incidents file, ie; Finch..Eglinton
+#define NO_STOP -1 // a location that is not on any line
+
+/*
+** Structures
+** -----------------------------------------------------
+*/
+
+// The stations and interlockings of each subway line (YUS, BDS, CYUS) in the
+// order they are along the line. Every place a location is on a line is a
+// stop, numbered by its ordinal along that line, so whether a location is
+// between two others is a comparison of ordinals.
+
+// lineCount is the number of lines
+// lineNames is the name of each line
+// stopCount is the number of stops on every line
+// stopNames is the location name of each stop
+// stopLine is the line of each stop, an index into lineNames
+// stopOrdinal is the position of each stop along its line, starting at 0
+// nextStop is the next stop with the same location name, a location such as an
+  // interchange is on more than one line. NO_STOP if there is none.
+// stopTable is a hash table of stopNames, each slot holds the first stop of a
+  // location name or NO_STOP
+// tableSize is the number of slots in stopTable, a power of two
+struct LineTopology {
+  int lineCount;
+  char** lineNames;
+  int stopCount;
+  char** stopNames;
+  int* stopLine;
+  int* stopOrdinal;
+  int* nextStop;
+  int* stopTable;
+  int tableSize;
+};
+
+/*
+** Function Prototypes
+** -----------------------------------------------------
+*/
+
+// Read in the order of the locations along each line, NULL if there is no file
+struct LineTopology* readInLineTopology(void);
+
+// Free a LineTopology and everything it holds
+void destroyLineTopology(struct LineTopology* lt);
+
+// Find the first stop of a location, NO_STOP if it is not on any line
+int findLineTopologyStop(struct LineTopology* lt, const char* location);
+
+// Find a line both ends of a range are on and their ordinals along it
+BOOL resolveLineRange(struct LineTopology* lt, const char* location1, const char* location2,
+  int* line, int* firstOrdinal, int* lastOrdinal);
+
+// Check if a location is on a line between two ordinals
+BOOL lineTopologyStopInRange(struct LineTopology* lt, const char* location, int line,
+  int firstOrdinal, int lastOrdinal);
+
+#endif
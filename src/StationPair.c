@@ -13,6 +13,10 @@
 ** 18 Feb 2016: Rev 2.0 - MWeston
 **                      - This file was introduced in this release
 **                      - Many methods are copied from Incidents.c file and adapted
+** 17 Oct 2026: Rev 5.1
+**                      - created indexStationPairList and findStationPair methods. Both lists
+**                        are read into a hash table, by conventional name for changeStationNames()
+**                        and by WBSS location and track for reassignTrackCircuitLocations()
 **
 */
 
@@ -23,6 +27,9 @@ void createStationPairList(struct StationPairList* spl) {
 	spl->head = NULL;
 	spl->tail = spl->head;
 	spl->count = 0;
+	spl->table = NULL;
+	spl->tableSize = 0;
+	spl->key = STATION_PAIR_BY_LOCATION1;
 }
 
 // Standard linked-list Queue style insert at the tail of the list
@@ -126,6 +133,7 @@ void destroyStationPairList(struct StationPairList* spl) {
 	while(spl->count > 0) {
 		removeAndDestroyStationPair(spl);
 	}
+	free(spl->table);
 	free(spl);
 }
 
@@ -193,6 +201,9 @@ void readInConvToWBSSList(struct StationPairList* spl) {
     printf("The file: '%s' could not be found. No Incidents will be disabled, All incident types will be emailed about\n", filePath);
   }
   
+  // the conventional names are looked up by changeStationNames()
+  indexStationPairList(spl, STATION_PAIR_BY_LOCATION1);
+
   //clean things up
   free(filePath);
 }
@@ -278,7 +289,98 @@ void readInTrackCircuitLocationReassignmentList(struct StationPairList* spl) {
     printf("The file: '%s' could not be found. No Incidents will be disabled, All incident types will be emailed about\n", filePath);
   }
   
+  // incidents are looked up by their location and track in reassignTrackCircuitLocations()
+  indexStationPairList(spl, STATION_PAIR_BY_LOCATION2_DATA2);
+
   //clean things up
   free(filePath);
   
 }
+
+// hash the key of a StationPair, its location1 or its location2 and data2
+//	key		- STATION_PAIR_BY_LOCATION1 or STATION_PAIR_BY_LOCATION2_DATA2
+//	location	- The location of the key
+//	data		- The data of the key, not used for STATION_PAIR_BY_LOCATION1
+//	return		- The hash
+static unsigned long hashStationPairKey(int key, const char* location, const char* data) {
+  unsigned long hash = hashString(location);
+  if(key == STATION_PAIR_BY_LOCATION2_DATA2) {
+    // the ';' between them keeps "ab","c" apart from "a","bc"
+    hash = hashStringWithSeed(data, hashStringWithSeed(SEMI_COLON, hash));
+  }
+  return hash;
+}
+
+// check if a StationPair has a key
+//	spl		- The StationPairList, its key says which fields are compared
+//	sp		- The StationPair
+//	location	- The location of the key
+//	data		- The data of the key, not used for STATION_PAIR_BY_LOCATION1
+//	return		- TRUE if the StationPair has the key, FALSE otherwise
+static BOOL stationPairHasKey(struct StationPairList* spl, struct StationPair* sp, const char* location, const char* data) {
+  if(spl->key == STATION_PAIR_BY_LOCATION1) {
+    return strcmp(sp->location1, location)==0;
+  }
+  return strcmp(sp->location2, location)==0 && strcmp(sp->data2, data)==0;
+}
+
+// find the slot of a key in the hash table, either the slot holding the first
+// StationPair with the key or the empty slot it would go in
+//	spl		- The StationPairList
+//	location	- The location of the key
+//	data		- The data of the key, not used for STATION_PAIR_BY_LOCATION1
+//	return		- The slot
+static int findStationPairSlot(struct StationPairList* spl, const char* location, const char* data) {
+  int slot = hashStationPairKey(spl->key, location, data) & (spl->tableSize - 1);
+  while(spl->table[slot] != NULL && !stationPairHasKey(spl, spl->table[slot], location, data)) {
+    slot = (slot + 1) & (spl->tableSize - 1);
+  }
+  return slot;
+}
+
+// Build a hash table of the StationPairs in a list. StationPairs with the same
+// key are chained by nextMatch in the order they are in the list, so the first
+// one found is the one a walk of the list would have found first.
+//	spl	- The StationPairList to index
+//	key	- STATION_PAIR_BY_LOCATION1 or STATION_PAIR_BY_LOCATION2_DATA2
+//	return	- Void
+void indexStationPairList(struct StationPairList* spl, int key) {
+  free(spl->table);
+  spl->key = key;
+  spl->tableSize = STATION_PAIR_TABLE_MIN_SIZE;
+  while(spl->tableSize < 2*spl->count) {
+    spl->tableSize *= 2;
+  }
+  spl->table = calloc(spl->tableSize, sizeof(struct StationPair*));
+
+  // the last StationPair of each chain, so the chain keeps the order of the list
+  struct StationPair** lastMatch = calloc(spl->tableSize, sizeof(struct StationPair*));
+  struct StationPair* sp = spl->head;
+  while(sp != NULL) {
+    sp->nextMatch = NULL;
+    const char* location = key == STATION_PAIR_BY_LOCATION1 ? sp->location1 : sp->location2;
+    int slot = findStationPairSlot(spl, location, sp->data2);
+    if(spl->table[slot] == NULL) {
+      spl->table[slot] = sp;
+    }
+    else {
+      lastMatch[slot]->nextMatch = sp;
+    }
+    lastMatch[slot] = sp;
+    sp = sp->next;
+  }
+  free(lastMatch);
+}
+
+// Find the first StationPair with a key. The others with the same key follow
+// it along nextMatch.
+//	spl		- The StationPairList, indexed by indexStationPairList
+//	location	- The location to look for
+//	data		- The data to look for, not used for STATION_PAIR_BY_LOCATION1
+//	return		- The first StationPair with the key, NULL if there is none
+struct StationPair* findStationPair(struct StationPairList* spl, const char* location, const char* data) {
+  if(spl->table == NULL) {
+    return NULL;
+  }
+  return spl->table[findStationPairSlot(spl, location, data)];
+}
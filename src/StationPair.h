@@ -2,6 +2,9 @@
 
 #define WBSS_MATCH_FOUND 800
 #define WBSS_MATCH_NOT_FOUND 801
+#define STATION_PAIR_BY_LOCATION1 810 // StationPairs are looked up by location1
+#define STATION_PAIR_BY_LOCATION2_DATA2 811 // StationPairs are looked up by location2 and data2
+#define STATION_PAIR_TABLE_MIN_SIZE 16 // fewest slots in the hash table of a StationPairList
 
 /*
 ** Structures
@@ -19,6 +22,8 @@
   // train
 // typeOfIncident is the type, CDF, CTDF, TF, etc
 // next is a pointer to the next StationPair struct sp the linked list.
+// nextMatch is the next StationPair in the list with the same key, NULL if
+  // there is none. ie; a conventional name with two WBSS names
 struct StationPair {
 	char* location1;
 	char* data1;
@@ -26,6 +31,7 @@ struct StationPair {
 	char* data2;
 
 	struct StationPair* next;
+	struct StationPair* nextMatch;
 };
 
 // container for StationPair structs
@@ -33,10 +39,17 @@ struct StationPair {
 // head is the first element
 // tail is the last element
 // count is the number of elements sp the linked list
+// table is a hash table of the StationPairs by key, each slot holds the first
+  // StationPair with a key or NULL. NULL until indexStationPairList is called
+// tableSize is the number of slots in table, a power of two
+// key is STATION_PAIR_BY_LOCATION1 or STATION_PAIR_BY_LOCATION2_DATA2
 struct StationPairList {
 	struct StationPair* head;
 	struct StationPair* tail;
 	int count;
+	struct StationPair** table;
+	int tableSize;
+	int key;
 };
 
 /*
@@ -69,3 +82,9 @@ void destroyStationPairList(struct StationPairList* spl);
 void readInConvToWBSSList(struct StationPairList* spl);
 
 void readInTrackCircuitLocationReassignmentList(struct StationPairList* spl);
+
+// Build a hash table of the StationPairs by location1 or by location2 and data2
+void indexStationPairList(struct StationPairList* spl, int key);
+
+// Find the first StationPair with a key, the rest follow it along nextMatch
+struct StationPair* findStationPair(struct StationPairList* spl, const char* location, const char* data);
@@ -1,5 +1,8 @@
 #include "StringAndFileMethods.h"
 #include "Incidents.h"
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
 
 /*------------------------------------------------------
 **
@@ -17,6 +20,11 @@
 **                      - modified readInLine method
  * 25 11 2016: Rev 2.2      - MTedesco
  *                          - Performance improvements made to removeFirstChars
+** 17 Oct 2026: Rev 5.1
+**                      - created findSubstring method, a vectorized substring search used by
+**                        getPositionOfSubstring, contains and getIndexOfStr
+**                      - getPositionOfSubstring returns -1 when the substring is not found
+**                      - created hashStringWithSeed method
 */
 
 // remove the first num chars from a string
@@ -36,12 +44,115 @@ void removeFirstChars(char *s, int num) {
 // and indexes
 //	str	- The string in which the substring will be searched for
 //	substr	- The substring to be searched for
-//	return	- an int representing the offset of the at which the substring starts
+//	return	- an int representing the offset of the at which the substring starts,
+//		  -1 if the substring is not found
 int getPositionOfSubstring(char* str, char* substr) {
-	char* ptr  = strstr( str, substr );
+	char* ptr  = findSubstring( str, substr );
+	if(ptr == NULL) {
+		return -1;
+	}
 	return ptr - str;
 }
 
+// Substring search
+// -----------------------------------------------------
+// findSubstring is used by contains(), getIndexOfStr() and getPositionOfSubstring()
+// for every log line, processing flag and template, so it is worth vectorizing.
+// On x86-64 the first and last char of the needle are compared against 16
+// positions of the haystack at once with SSE2 and only the positions where
+// both match are checked in full. Anywhere else a plain search is used.
+// There is no AVX2 version, on the log lines the tool searches it was no
+// faster than SSE2, the lines are too short for 32 positions at a time to pay.
+// The tool is built without optimization (see makefile), so the search
+// functions ask gcc for it themselves, otherwise the intrinsics are not inlined
+// and the vector searches end up slower than the plain one.
+// The search functions below are given the lengths of both strings, and the
+// needle is at least 1 char and no longer than the haystack.
+
+// plain search, jumps to each occurrence of the first char with memchr
+//	haystack	- The string to be searched in
+//	haystackLength	- The length of haystack
+//	needle		- The string to be searched for
+//	needleLength	- The length of needle
+//	return		- A pointer to the first occurrence of needle in haystack, NULL if there is none
+__attribute__((optimize("O2")))
+static char* findSubstringScalar(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength) {
+	const char* last = haystack + haystackLength - needleLength;
+	const char* candidate = haystack;
+	
+	while(candidate <= last) {
+		candidate = (const char*)memchr(candidate, needle[0], last - candidate + 1);
+		if(candidate == NULL) {
+			return NULL;
+		}
+		if(memcmp(candidate + 1, needle + 1, needleLength - 1) == 0) {
+			return (char*)candidate;
+		}
+		candidate++;
+	}
+	return NULL;
+}
+
+#if defined(__x86_64__)
+// SSE2 search, SSE2 is part of every x86-64 CPU
+//	haystack	- The string to be searched in
+//	haystackLength	- The length of haystack
+//	needle		- The string to be searched for
+//	needleLength	- The length of needle
+//	return		- A pointer to the first occurrence of needle in haystack, NULL if there is none
+__attribute__((optimize("O2")))
+static char* findSubstringSSE2(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength) {
+	if(needleLength == 1) {
+		return (char*)memchr(haystack, needle[0], haystackLength);
+	}
+	const __m128i first = _mm_set1_epi8(needle[0]);
+	const __m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+	size_t i;
+	
+	// every block of 16 starting positions whose last chars are in the haystack
+	for(i = 0; i + needleLength - 1 + 16 <= haystackLength; i += 16) {
+		const __m128i blockFirst = _mm_loadu_si128((const __m128i*)(haystack + i));
+		const __m128i blockLast = _mm_loadu_si128((const __m128i*)(haystack + i + needleLength - 1));
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)));
+		
+		while(mask != 0) {
+			unsigned int bit = (unsigned int)__builtin_ctz(mask);
+			if(memcmp(haystack + i + bit + 1, needle + 1, needleLength - 2) == 0) {
+				return (char*)(haystack + i + bit);
+			}
+			mask &= mask - 1;
+		}
+	}
+	// the positions left over
+	return findSubstringScalar(haystack + i, haystackLength - i, needle, needleLength);
+}
+#endif
+
+// find the first occurrence of a substring within another, a drop in
+// replacement for strstr()
+//	haystack	- The string in which the substring will be searched for
+//	needle		- The substring to be searched for
+//	return		- A pointer to the start of the substring within haystack, NULL if it
+//			  is not found. haystack is returned if needle is empty, the same as strstr()
+char* findSubstring(const char* haystack, const char* needle) {
+	size_t needleLength = strlen(needle);
+	size_t haystackLength;
+	
+	if(needleLength == 0) {
+		return (char*)haystack;
+	}
+	haystackLength = strlen(haystack);
+	if(needleLength > haystackLength) {
+		return NULL;
+	}
+#if defined(__x86_64__)
+	return findSubstringSSE2(haystack, haystackLength, needle, needleLength);
+#else
+	return findSubstringScalar(haystack, haystackLength, needle, needleLength);
+#endif
+}
+
 // copy chars from one string into another until a certain word within the
 // main string
 //	str		- The string that will be copied up to a point
@@ -197,3 +308,24 @@ int readInLine(FILE* fl, char** line, size_t size) {
   }
 }
 
+// compute a short hash of a string (djb2). Used to check a line read in from a
+// file against a previously saved one without storing and comparing the line
+//	str	- The string to be hashed
+//	return	- The hash of the string
+unsigned long hashString(const char* str) {
+  return hashStringWithSeed(str, 5381);
+}
+
+// continue a djb2 hash over another string, so several strings can be hashed
+// together without joining them
+//	str	- The string to be hashed
+//	seed	- The hash so far, 5381 to start a new hash
+//	return	- The hash of the string
+unsigned long hashStringWithSeed(const char* str, unsigned long seed) {
+  unsigned long hash = seed;
+  int c;
+  while((c = (unsigned char)*str++)) {
+    hash = ((hash << 5) + hash) + c; // hash * 33 + c
+  }
+  return hash;
+}
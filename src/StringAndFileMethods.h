@@ -6,6 +6,9 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 
 #define BOOL int
 #define TRUE 1
@@ -119,6 +122,10 @@ void removeFirstChars(char *s, int num);
 // and indexes
 int getPositionOfSubstring(char* str, char* substr);
 
+// find the first occurrence of a substring within another, a drop in
+// replacement for strstr() that uses SSE2 on x86-64
+char* findSubstring(const char* haystack, const char* needle);
+
 // copy chars from one string into another until a certain word within the
 // main string
 void getCharsUpTo(char* str, char* output, char* afterWord);
@@ -129,3 +136,10 @@ void getCharsUpTo(char* str, char* output, char* afterWord);
 // dynamically resize the char array if string is too long
 // filters out comments
 int readInLine(FILE* fl, char** line, size_t size);
+
+// compute a short hash of a string (djb2). Used to check a line read in from a
+// file against a previously saved one without storing and comparing the line
+unsigned long hashString(const char* str);
+
+// continue a djb2 hash over another string
+unsigned long hashStringWithSeed(const char* str, unsigned long seed);
@@ -0,0 +1,258 @@
+// The search functions of StringAndFileMethods.c are static, so the file is
+// built into this program to time and check each of them on its own
+#include "StringAndFileMethods.c"
+
+/*------------------------------------------------------
+**
+** File: SubstringBenchmark.c
+** Created: October 17, 2026
+**
+** Copyright �2015 Toronto Transit Commission
+**
+** Revision History
+**
+** 17 Oct 2026: Rev 5.1
+**                      - This file was introduced in this release
+**                      - checks findSubstring and the searches behind it against strstr on
+**                        random strings, then times them against the contains() loop they
+**                        replaced on CSS log lines. Built with "make benchmark", it is not
+**                        part of the tool
+**
+*/
+
+#define BENCHMARK_CHECK_CASES 2000000 // random haystack/needle pairs checked against strstr
+#define BENCHMARK_ROUNDS 200000 // times every keyword is searched for in every line
+#define BENCHMARK_MAX_HAYSTACK 200 // longest random haystack that is checked
+#define BENCHMARK_MAX_NEEDLE 8 // longest random needle that is checked
+
+// lines and keywords like the ones the tool searches, the keywords are the
+// literal keywords of typical incident types in Incident_Types.txt
+static const char* benchmarkLines[] = {
+	"02:19:06 06/14/15 LOCATION Warden SWITCH 15A CRITICAL DETECTION FAILURE",
+	"00:00:02 06/14/15 TRAIN R107FV234541A TRIGGERED DEPARTURE AT Eglinton",
+	"00:00:04 06/14/15 LOCATION St. Clair West INDICATION - SPECIAL SSCW6TATE OFF",
+	"00:00:02 06/14/15 LOCATION Glencairn INDICATION - SIGNAL 2 STOP",
+	"17:39:54 10/17/26 LOCATION Greenwood SIGNAL 2 STOP LAMP FAILED"
+};
+static const char* benchmarkKeywords[] = {
+	"CRITICAL DETECTION FAILURE",
+	"STOP LAMP FAILED",
+	"BRAKE FAULT AT",
+	" SWITCH",
+	"LOCATION"
+};
+
+// the contains() loop from before findSubstring, kept here to be timed against
+//	string		- The string to be searched in
+//	substring	- The string to be searched for
+//	return		- TRUE if substring is in string, FALSE otherwise
+static BOOL oldContains(const char* string, const char* substring) {
+	BOOL found = FALSE;
+	int offset = 0;
+	while(!found && *(string + offset) != '\0') {
+		if(*(string + offset) == *substring) {
+			int i = 0;
+			while(*(string + offset + i) == *(substring + i) && !found) {
+				i++;
+				if(*(substring + i) == '\0') {
+					found = TRUE;
+				}
+			}
+		}
+		offset++;
+	}
+	return found;
+}
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+
+// the AVX2 search that findSubstring used to pick on CPUs with AVX2, the same
+// as the SSE2 search with 32 positions at a time. It is kept here so the
+// reason it was dropped can be measured again.
+//	haystack	- The string to be searched in
+//	haystackLength	- The length of haystack
+//	needle		- The string to be searched for
+//	needleLength	- The length of needle
+//	return		- A pointer to the first occurrence of needle in haystack, NULL if there is none
+__attribute__((target("avx2"), optimize("O2")))
+static char* findSubstringAVX2(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength) {
+	if(needleLength == 1) {
+		return (char*)memchr(haystack, needle[0], haystackLength);
+	}
+	const __m256i first = _mm256_set1_epi8(needle[0]);
+	const __m256i last = _mm256_set1_epi8(needle[needleLength - 1]);
+	size_t i;
+
+	for(i = 0; i + needleLength - 1 + 32 <= haystackLength; i += 32) {
+		const __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(haystack + i));
+		const __m256i blockLast = _mm256_loadu_si256((const __m256i*)(haystack + i + needleLength - 1));
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+			_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast)));
+
+		while(mask != 0) {
+			unsigned int bit = (unsigned int)__builtin_ctz(mask);
+			if(memcmp(haystack + i + bit + 1, needle + 1, needleLength - 2) == 0) {
+				return (char*)(haystack + i + bit);
+			}
+			mask &= mask - 1;
+		}
+	}
+	return findSubstringSSE2(haystack + i, haystackLength - i, needle, needleLength);
+}
+#endif
+
+// the ways of searching that are checked and timed, a search is given the
+// strings and their lengths and returns where needle is, NULL if it is not
+// there. oldContains only says if it is there, so it is only timed.
+#define SEARCH_OLD_CONTAINS 0
+#define SEARCH_STRSTR 1
+#define SEARCH_FIND_SUBSTRING 2
+#define SEARCH_SCALAR 3
+#define SEARCH_SSE2 4
+#define SEARCH_AVX2 5
+#define SEARCH_COUNT 6
+
+static const char* searchNames[SEARCH_COUNT] = {
+	"old contains()", "strstr", "findSubstring", "scalar", "SSE2", "AVX2"
+};
+
+// is a search built in and can it run on this CPU
+//	search	- The SEARCH_ number of the search
+//	return	- TRUE if it can be run, FALSE otherwise
+static BOOL searchAvailable(int search) {
+#if defined(__x86_64__)
+	if(search == SEARCH_AVX2) {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") ? TRUE : FALSE;
+	}
+	return TRUE;
+#else
+	return search != SEARCH_SSE2 && search != SEARCH_AVX2;
+#endif
+}
+
+// run one search
+//	search		- The SEARCH_ number of the search
+//	haystack	- The string to be searched in
+//	haystackLength	- The length of haystack
+//	needle		- The string to be searched for, at least 1 char
+//	needleLength	- The length of needle
+//	return		- Where needle is in haystack, NULL if it is not. For
+//			  SEARCH_OLD_CONTAINS haystack if it is there
+static const char* runSearch(int search, const char* haystack, size_t haystackLength, const char* needle, size_t needleLength) {
+	if(needleLength > haystackLength && search >= SEARCH_SCALAR) {
+		return NULL;
+	}
+	switch(search) {
+		case SEARCH_OLD_CONTAINS:
+			return oldContains(haystack, needle) ? haystack : NULL;
+		case SEARCH_STRSTR:
+			return strstr(haystack, needle);
+		case SEARCH_FIND_SUBSTRING:
+			return findSubstring(haystack, needle);
+		case SEARCH_SCALAR:
+			return findSubstringScalar(haystack, haystackLength, needle, needleLength);
+#if defined(__x86_64__)
+		case SEARCH_SSE2:
+			return findSubstringSSE2(haystack, haystackLength, needle, needleLength);
+		case SEARCH_AVX2:
+			return findSubstringAVX2(haystack, haystackLength, needle, needleLength);
+#endif
+		default:
+			return NULL;
+	}
+}
+
+// check every search that returns a position against strstr on random strings
+// of a few letters, so that needles are often found and often nearly found
+//	return	- The number of cases a search did not agree with strstr
+static long checkAgainstStrstr(void) {
+	char haystack[BENCHMARK_MAX_HAYSTACK + 1];
+	char needle[BENCHMARK_MAX_NEEDLE + 1];
+	long failures = 0;
+	long c;
+
+	srand(1);
+	for(c = 0; c < BENCHMARK_CHECK_CASES; c++) {
+		int haystackLength = rand() % (BENCHMARK_MAX_HAYSTACK + 1);
+		int needleLength = 1 + rand() % BENCHMARK_MAX_NEEDLE;
+		int i;
+		for(i = 0; i < haystackLength; i++) {
+			haystack[i] = 'a' + rand() % 3;
+		}
+		haystack[haystackLength] = '\0';
+		for(i = 0; i < needleLength; i++) {
+			needle[i] = 'a' + rand() % 3;
+		}
+		needle[needleLength] = '\0';
+
+		const char* expected = strstr(haystack, needle);
+		int search;
+		for(search = SEARCH_FIND_SUBSTRING; search < SEARCH_COUNT; search++) {
+			if(searchAvailable(search) &&
+			  runSearch(search, haystack, haystackLength, needle, needleLength) != expected) {
+				if(failures < 10) {
+					printf("%s does not agree with strstr for |%s| in |%s|\n", searchNames[search], needle, haystack);
+				}
+				failures++;
+			}
+		}
+	}
+	return failures;
+}
+
+// time one search over every keyword and line
+//	search	- The SEARCH_ number of the search
+//	return	- The average time of one search in ns
+static double timeSearch(int search) {
+	int lineCount = sizeof(benchmarkLines)/sizeof(benchmarkLines[0]);
+	int keywordCount = sizeof(benchmarkKeywords)/sizeof(benchmarkKeywords[0]);
+	size_t lineLengths[sizeof(benchmarkLines)/sizeof(benchmarkLines[0])];
+	size_t keywordLengths[sizeof(benchmarkKeywords)/sizeof(benchmarkKeywords[0])];
+	struct timespec start;
+	struct timespec end;
+	// a count of the matches, printed so the searches are not optimized away
+	volatile long found = 0;
+	int l;
+	int k;
+	long r;
+
+	for(l = 0; l < lineCount; l++) {
+		lineLengths[l] = strlen(benchmarkLines[l]);
+	}
+	for(k = 0; k < keywordCount; k++) {
+		keywordLengths[k] = strlen(benchmarkKeywords[k]);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(r = 0; r < BENCHMARK_ROUNDS; r++) {
+		for(l = 0; l < lineCount; l++) {
+			for(k = 0; k < keywordCount; k++) {
+				if(runSearch(search, benchmarkLines[l], lineLengths[l], benchmarkKeywords[k], keywordLengths[k]) != NULL) {
+					found++;
+				}
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	double ns = (end.tv_sec - start.tv_sec)*1e9 + (end.tv_nsec - start.tv_nsec);
+	return ns/((double)BENCHMARK_ROUNDS*lineCount*keywordCount);
+}
+
+int main(void) {
+	int search;
+
+	long failures = checkAgainstStrstr();
+	printf("%d random cases checked against strstr, %ld disagreed\n", BENCHMARK_CHECK_CASES, failures);
+
+	for(search = 0; search < SEARCH_COUNT; search++) {
+		if(searchAvailable(search)) {
+			printf("%-16s %6.1f ns/search\n", searchNames[search], timeSearch(search));
+		}
+		else {
+			printf("%-16s not supported on this CPU\n", searchNames[search]);
+		}
+	}
+	return failures == 0 ? 0 : 1;
+}
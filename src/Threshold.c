@@ -13,6 +13,10 @@
 ** 18 Feb 2016: Rev 2.0 - MWeston
 **                      - Changed #include files
 **                      - 
+** 17 Oct 2026: Rev 5.1
+**                      - created getThresholdListKey method
+**                      - a threshold can be checked on buckets of time, created getTimeExpiringTime,
+**                        getBucketMinutes and getBucketExpiringTime methods
 */
 
 // initialize filed for threshold list
@@ -51,7 +55,13 @@ void printThresholdList(struct ThresholdList* tl) {
 	struct Threshold* tmp = tl->head;
 	if(tl->count > 0) {
 		while(tmp != NULL) {
-			printf("%d incidents in %d minutes\n", tmp->numOfIncidents, tmp->numOfMinutes);
+			if(tmp->bucketMinutes > 0) {
+				printf("%d incidents in %d minutes, in buckets of %d minutes\n", tmp->numOfIncidents,
+				  tmp->numOfMinutes, tmp->bucketMinutes);
+			}
+			else {
+				printf("%d incidents in %d minutes\n", tmp->numOfIncidents, tmp->numOfMinutes);
+			}
 			tmp = tmp->next;
 		}
 	}
@@ -147,6 +157,95 @@ int getExpiringTime(struct ThresholdList* tl) {
     return DEFAULT_THRESHOLD_TIME;
   }
 }
+// This method will return the number of minutes the time of every incident
+// must be kept for. It is the largest 'number of minutes' of the thresholds
+// that are not checked on buckets of time, and the time of the incidents of
+// the newest bucket of a bucketed threshold are kept so they can be emailed.
+// The same as getExpiringTime if no threshold is bucketed.
+//	tl	- The Threshold List to be searched
+//	return	- The number of minutes
+int getTimeExpiringTime(struct ThresholdList* tl) {
+  if(tl->count > 0) {
+    int max=0;
+    struct Threshold* th = tl->head;
+    while(th != NULL)
+    {
+      int minutes = th->bucketMinutes > 0 ? th->bucketMinutes : th->numOfMinutes;
+      if(minutes > max) 
+      {
+        max = minutes; 
+      }
+      th=th->next;
+    }
+    return max;
+  }
+  else {
+    return DEFAULT_THRESHOLD_TIME;
+  }
+}
+
+// The size of the buckets of time the incidents of a record are counted in,
+// the smallest bucket size of the bucketed thresholds. A threshold with larger
+// buckets is checked on the smaller ones.
+//	tl	- The Threshold List to be searched
+//	return	- The number of minutes in a bucket, 0 if no threshold is bucketed
+int getBucketMinutes(struct ThresholdList* tl) {
+  int min = 0;
+  struct Threshold* th = tl->head;
+  while(th != NULL)
+  {
+    if(th->bucketMinutes > 0 && (min == 0 || th->bucketMinutes < min))
+    {
+      min = th->bucketMinutes;
+    }
+    th=th->next;
+  }
+  return min;
+}
+
+// The number of minutes the buckets of time must cover, the largest 'number of
+// minutes' of the bucketed thresholds
+//	tl	- The Threshold List to be searched
+//	return	- The number of minutes, 0 if no threshold is bucketed
+int getBucketExpiringTime(struct ThresholdList* tl) {
+  int max = 0;
+  struct Threshold* th = tl->head;
+  while(th != NULL)
+  {
+    if(th->bucketMinutes > 0 && th->numOfMinutes > max)
+    {
+      max = th->numOfMinutes;
+    }
+    th=th->next;
+  }
+  return max;
+}
+
+// A key for the threshold conditions of a list, a hash of the number of
+// incidents and number of minutes of each threshold in order. It is saved with
+// what was worked out from the thresholds, so a change to them can be noticed.
+//	tl	- The Threshold List
+//	return	- The key
+unsigned long getThresholdListKey(struct ThresholdList* tl) {
+  unsigned long key = hashString("");
+  char condition[STRING_LENGTH];
+  struct Threshold* th = tl->head;
+  while(th != NULL)
+  {
+    if(th->bucketMinutes > 0)
+    {
+      sprintf(condition, "%d,%d,%d;", th->numOfIncidents, th->numOfMinutes, th->bucketMinutes);
+    }
+    else
+    {
+      sprintf(condition, "%d,%d;", th->numOfIncidents, th->numOfMinutes);
+    }
+    key = hashStringWithSeed(condition, key);
+    th = th->next;
+  }
+  return key;
+}
+
 //goes through the threshold list and free all thresholds and then the threshold list
 //	thresholdList	- The Theshold List to be deleted
 //	return		- Void
@@ -14,10 +14,15 @@
 
 // numOfIncidents is the number of incidents
 // numOfHours is the number of minutes
+// bucketMinutes is the size of the buckets of time the threshold is checked
+  // on, 0 if it is checked on the time of every incident. Written as a third
+  // number in Incident_Types.txt, [50,10080,60] is 50 incidents in a week
+  // counted in buckets of an hour
 // next is a pointer to the next object in a linked-list
 struct Threshold {
 	int numOfIncidents;
 	int numOfMinutes;
+	int bucketMinutes;
   struct Threshold* next;
 };
 
@@ -65,3 +70,15 @@ void destroyThresholdList(struct ThresholdList* tl);
 void deleteThresholdList(struct ThresholdList* thresholdList);
 
 int getExpiringTime(struct ThresholdList* tl);
+
+// the number of minutes the time of every incident must be kept for
+int getTimeExpiringTime(struct ThresholdList* tl);
+
+// the size of the buckets of time records are counted in, 0 if no threshold is bucketed
+int getBucketMinutes(struct ThresholdList* tl);
+
+// the number of minutes the buckets of time must cover
+int getBucketExpiringTime(struct ThresholdList* tl);
+
+// a key for the threshold conditions of a list, to notice a change to them
+unsigned long getThresholdListKey(struct ThresholdList* tl);
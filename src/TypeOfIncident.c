@@ -13,6 +13,9 @@
 ** 18 Feb 2016: Rev 2.0 - MWeston
 **                      - Changed #include files
 **                      - Created typeOfIncidentListContain method
+** 17 Oct 2026: Rev 5.1
+**                      - added a bitset of type ids to TypeOfIncidentList, created
+**                        typeOfIncidentListContainId method
 */
 
 // Initialize list
@@ -22,6 +25,7 @@ void createTypeOfIncidentList(struct TypeOfIncidentList* toil) {
 	toil->head = NULL;
 	toil->tail = toil->head;
 	toil->count = 0;
+	toil->typeBits = NULL;
 }
 
 // Insert TypeOfIncident into TypeOfIncidentList at the tail
@@ -118,6 +122,7 @@ void destroyTypeOfIncidentList(struct TypeOfIncidentList* toil) {
 	while(toil->count > 0) {
 		removeAndDestroyTypeOfIncident(toil);
 	}
+	free(toil->typeBits);
 	free(toil);
 }
 
@@ -135,3 +140,15 @@ BOOL typeOfIncidentListContain(struct TypeOfIncidentList* toil, char* typeOfInci
   }
   return FALSE;
 }
+
+// check to see if the TypeOfIncidentList struct 'toil' contains a type of incident
+// by its type id, one bit of the type bitset is tested
+//	toil		- The Type Of Incident List, its type bitset built by buildTypeOfIncidentBits
+//	typeId		- The type id of the type of incident to be searched for
+//	return		- A BOOL indicating whether the type of incident was found(TRUE) or not(FALSE)
+BOOL typeOfIncidentListContainId(struct TypeOfIncidentList* toil, int typeId) {
+  if(toil->typeBits == NULL || typeId == NO_TYPE_ID) {
+    return FALSE;
+  }
+  return (toil->typeBits[typeId / TYPE_ID_WORD_BITS] >> (typeId % TYPE_ID_WORD_BITS)) & 1ULL;
+}
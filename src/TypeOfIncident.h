@@ -2,6 +2,9 @@
 #define TYPEOFINCIDENT_H
 #include "StringAndFileMethods.h"
 
+#define NO_TYPE_ID -1 // the id of a type of incident that is not in the IncidentTypeList
+#define TYPE_ID_WORD_BITS 64 // number of type ids held in each word of a type bitset
+
 /*
 ** Structures
 ** -----------------------------------------------------
@@ -17,10 +20,14 @@ struct TypeOfIncident {
 };
 
 // Container for linked list of incident types
+// typeBits is a bitset with a bit set for the type id of each incident type in
+  // the list, every bit is set if the list holds "ALL". NULL until it is built
+  // by buildTypeOfIncidentBits
 struct TypeOfIncidentList {
 	struct TypeOfIncident* head;
 	struct TypeOfIncident* tail;
 	int count;
+	unsigned long long* typeBits;
 };
 
 /*
@@ -53,4 +60,7 @@ void destroyTypeOfIncidentList(struct TypeOfIncidentList* toil);
 // check to see if the TypeOfIncidentList struct 'toil' contains the TypeOfIncident 'typeOfIncident'
 BOOL typeOfIncidentListContain(struct TypeOfIncidentList* toil, char* typeOfIncident);
 
+// check the type bitset of 'toil' for a type id
+BOOL typeOfIncidentListContainId(struct TypeOfIncidentList* toil, int typeId);
+
 #endif
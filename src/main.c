@@ -83,6 +83,27 @@
 **		- Implemented object types within Incident_Types.txt 
 ** 		- Streamlined addIncidentToEmail() function & grouped tables based on incident type
 ** 		- Critical Incidents display an image on the right side
+**
+** 17 Oct 2026: Rev 5.1
+**		- getHeaderLine() and fullNameFromPartial() use findSubstring instead of strstr
+**		- readInCCMapping() returns a CCMapping, the CCPair list indexed by CC number in an array
+**		  with a sorted array for outliers. The car number strings of each CC are formatted once
+**		  when it is read in. created findCCPair, replaced deleteCCPairList with deleteCCMapping
+**		- getCarNum() no longer walks the whole list, getFormatedLine() and getCarNumString()
+**		  look the CC up once and copy its car number string
+**		- Recipients are matched to incidents by type id. The type bitset of each EmailInfo is
+**		  built once it is read in and sendSummaryEmails() finds the IncidentType of a summary
+**		  email by its type id
+**		- The processing flags of an incident type are tested as bits of its compiled flags and
+**		  the table layout of addIncidentToEmail() is picked once when the type is read in
+**		- addIncidentToEmail() is given the position of the first time that met the threshold
+**		  and reads the times from the array of the record's TimeList
+**		- addIncidentToEmail() lists the times that are kept for a threshold checked on buckets
+**		  of time, sendSummaryEmails() leaves those thresholds out
+**		- addIncidentToEmail() writes to the EmailBuffer of the type of incident so the types can
+**		  be processed on threads, created addEmailBufferToEmails to add each buffer to the
+**		  .html files and subject lines. add_to_subject_line() takes the location and data
+**		  of the record instead of the record. main() calls processIncidentTypes
 */
 
 //program defined const variables
@@ -100,6 +121,10 @@ static const struct IncidentType VHLC_ADTSS_IncidentType =
 		.emailTemplateLocation = "VHLC AUTO DTS SWITCHOVER - AT \\L : FROM \\K TO \\E",
 		.processingFlags = "SV",
 		.thresholdList = NULL,
+		.typeId = NO_TYPE_ID,
+		.flags = SERVER_NAME_SWITCH_BIT | CHECK_TCS_VHLC_SERVER_BIT,
+		.postParseStepCount = 0,
+		.tableLayout = TABLE_LAYOUT_VHLC_CHANNEL,
 		.next = NULL
 	};
 static const struct IncidentType VHLC_FEPTO_IncidentType =
@@ -111,6 +136,10 @@ static const struct IncidentType VHLC_FEPTO_IncidentType =
 		.emailTemplateLocation = "VHLC COMMUNICATION FAULT - CHANNEL \\K \\E AT \\L",
 		.processingFlags = "SV",
 		.thresholdList = NULL,
+		.typeId = NO_TYPE_ID,
+		.flags = SERVER_NAME_SWITCH_BIT | CHECK_TCS_VHLC_SERVER_BIT,
+		.postParseStepCount = 0,
+		.tableLayout = TABLE_LAYOUT_VHLC_CHANNEL,
 		.next = NULL
 	};
 
@@ -119,43 +148,160 @@ static const struct IncidentType VHLC_FEPTO_IncidentType =
 //E.G: 7682 --> QP to FI
 const char* ZCS2STATION[3] = {"VMC to MU","QP to FI","MTT"};
 
-// Recursively deletes the linked list mapping CC number to TR/RT number
-//   ccPairLLHead -- Pointer to the head of the linked list
+// the CCPair of every CC id that is not in CC_Mapping.txt, its car number is NO_CAR_NUMBER
+static struct CCPair unmappedCCPair = { NO_CAR_NUMBER, NO_CAR_NUMBER, "", "", NULL };
+
+// Deletes the table mapping CC number to TR/RT number and the linked list it holds
+//   ccMapping -- The table read in by readInCCMapping
 void
-deleteCCPairList(struct CCPair* ccPairLLHead)
+deleteCCMapping(struct CCMapping* ccMapping)
 {
+	if (NULL == ccMapping) {
+		return;
+	}
+	struct CCPair* ccPairLLHead = ccMapping->head;
 	struct CCPair* temp;
 	while (NULL != ccPairLLHead){
 		temp = ccPairLLHead;
 		ccPairLLHead = ccPairLLHead->next;
 		free(temp);
 	}
+	free(ccMapping->dense);
+	free(ccMapping->sparse);
+	free(ccMapping);
+}
+
+// For a given CC number, find its CCPair
+//   CC -- The CC number of the train reported in the alarm
+//   ccMapping -- The table mapping CC number to TR/RT number
+//   return -- The CCPair of the CC number, the unmapped sentinel whose car number is
+//             NO_CAR_NUMBER if the CC number is not in the table
+const struct CCPair*
+findCCPair(int CC, struct CCMapping* ccMapping)
+{
+	if (NULL == ccMapping) {
+		return &unmappedCCPair;
+	}
+	if (CC >= 0 && CC < ccMapping->denseSize) {
+		return ccMapping->dense[CC];
+	}
+	// ids that are negative or too large for the array are binary searched
+	int low = 0;
+	int high = ccMapping->sparseCount;
+	while (low < high) {
+		int middle = (low + high) / 2;
+		if (ccMapping->sparse[middle]->cc < CC) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+	if (low < ccMapping->sparseCount && ccMapping->sparse[low]->cc == CC) {
+		return ccMapping->sparse[low];
+	}
+	return &unmappedCCPair;
 }
 
 // For a given CC number, retrieve the TR/RT number
 //   CC -- The CC number of the train reported in the alarm
-//   ccPairLLHead -- Pointer to the head of the linked list mapping CC number to TR/RT number
-//   return -- Returns the TR/RT number from the linked list
+//   ccMapping -- The table mapping CC number to TR/RT number
+//   return -- Returns the TR/RT number, NO_CAR_NUMBER if the CC number is not mapped
 int
-getCarNum(int CC, struct CCPair* ccPairLLHead)
+getCarNum(int CC, struct CCMapping* ccMapping)
 {
-	// Initialize return value to invalid number
-	// If this invalid value is returned, error message will be output in the email notification
-	int carNum = -1;
-	//Traverse the linked list
-	while (NULL != ccPairLLHead) {
-		if (CC == ccPairLLHead->cc) {
-			carNum = ccPairLLHead->carNum;
+	// If NO_CAR_NUMBER is returned, error message will be output in the email notification
+	return findCCPair(CC, ccMapping)->carNum;
+}
+
+// Fill in the car number strings of a CCPair once, so they are not formatted
+// again for every incident
+//   ccPair -- The CCPair with its cc and carNum read in
+static void
+formatCarNumber(struct CCPair* ccPair)
+{
+	if (ccPair->cc < 100)
+	{
+		snprintf(ccPair->carNumString, CAR_NUM_STRING_LENGTH, "TR%d", ccPair->carNum);
+		snprintf(ccPair->carNumLabel, CAR_NUM_STRING_LENGTH, "%d", ccPair->carNum);
+	}
+	else if ((ccPair->cc < 119) && (ccPair->cc > 109))
+	{
+		snprintf(ccPair->carNumString, CAR_NUM_STRING_LENGTH, "RT-%d/%d", ccPair->carNum, ccPair->carNum+1);
+		strcpy(ccPair->carNumLabel, ccPair->carNumString);
+	}
+	else
+	{
+		snprintf(ccPair->carNumString, CAR_NUM_STRING_LENGTH, "RT-%d", ccPair->carNum);
+		strcpy(ccPair->carNumLabel, ccPair->carNumString);
+	}
+}
+
+// order CCPairs by CC number, for qsort. Pairs with the same number keep the
+// order they are in the file.
+//   a -- The first CCPair
+//   b -- The second CCPair
+//   return -- Less than, equal to or greater than 0 as a comes before, with or after b
+static int
+compareCCPairs(const void* a, const void* b)
+{
+	const struct CCPair* pairA = *(const struct CCPair* const*)a;
+	const struct CCPair* pairB = *(const struct CCPair* const*)b;
+	if (pairA->cc != pairB->cc) {
+		return (pairA->cc > pairB->cc) - (pairA->cc < pairB->cc);
+	}
+	return (pairA > pairB) - (pairA < pairB);
+}
+
+// Build the lookup table of a CCMapping from its linked list. When a CC number
+// is in the file more than once the last line wins, as it did when the list was searched.
+//   ccMapping -- The CCMapping with its linked list read in
+static void
+indexCCMapping(struct CCMapping* ccMapping)
+{
+	struct CCPair* ccPair;
+	int count = 0;
+	ccMapping->denseSize = 0;
+	for (ccPair = ccMapping->head; NULL != ccPair; ccPair = ccPair->next) {
+		if (ccPair->cc >= 0 && ccPair->cc < CC_MAPPING_DENSE_LIMIT && ccPair->cc >= ccMapping->denseSize) {
+			ccMapping->denseSize = ccPair->cc + 1;
 		}
-		ccPairLLHead = ccPairLLHead->next;
+		count++;
+	}
+
+	int i;
+	ccMapping->dense = (struct CCPair**)malloc((ccMapping->denseSize + 1) * sizeof(struct CCPair*));
+	for (i = 0; i < ccMapping->denseSize; i++) {
+		ccMapping->dense[i] = &unmappedCCPair;
+	}
+	ccMapping->sparse = (struct CCPair**)malloc((count + 1) * sizeof(struct CCPair*));
+	ccMapping->sparseCount = 0;
+	for (ccPair = ccMapping->head; NULL != ccPair; ccPair = ccPair->next) {
+		if (ccPair->cc >= 0 && ccPair->cc < ccMapping->denseSize) {
+			ccMapping->dense[ccPair->cc] = ccPair;
+		}
+		else {
+			ccMapping->sparse[ccMapping->sparseCount++] = ccPair;
+		}
+	}
+
+	// sort the outliers and keep only the last pair of each CC number
+	qsort(ccMapping->sparse, ccMapping->sparseCount, sizeof(struct CCPair*), compareCCPairs);
+	int kept = 0;
+	for (i = 0; i < ccMapping->sparseCount; i++) {
+		if (kept > 0 && ccMapping->sparse[kept - 1]->cc == ccMapping->sparse[i]->cc) {
+			kept--;
+		}
+		ccMapping->sparse[kept++] = ccMapping->sparse[i];
 	}
-	return carNum;
+	ccMapping->sparseCount = kept;
 }
 
-//  read in ./Other/CC_Mapping.txt file into an array of CCPair struct
+//  read in ./Other/CC_Mapping.txt file into a linked list of CCPair structs and
+//  index it by CC number
 //  
-//	return		-- Linked list of struct CCPair
-struct CCPair* readInCCMapping() 
+//	return		-- The CCMapping, NULL if the file could not be read in
+struct CCMapping* readInCCMapping() 
 {
   struct CCPair* head = NULL; //points to the head of the linked list
   struct CCPair* tail = NULL; //points to the end of the linked list
@@ -184,6 +330,7 @@ struct CCPair* readInCCMapping()
 			//CCID,CAR_NUM
 			cc_pair->cc=atoi(strtok(tmp, ","));
 			cc_pair->carNum=atoi(strtok(NULL, ","));
+			formatCarNumber(cc_pair);
 			//If the head is NULL, add the CCPair struct to the head of the linked list.
 			//Otherwise, append to the linked list.
 			if (NULL == head){
@@ -215,7 +362,11 @@ struct CCPair* readInCCMapping()
   //clean things up
   free(tmp);
   free(filePath);
-  return head;
+
+  struct CCMapping* ccMapping = (struct CCMapping*)malloc(sizeof(struct CCMapping));
+  ccMapping->head = head;
+  indexCCMapping(ccMapping);
+  return ccMapping;
 }
 
 
@@ -228,12 +379,12 @@ BOOL checkCriticalAlert(const struct IncidentType* incidentType,const char* data
 {
 	BOOL isCriticalIncident = FALSE;
 	//checks if the incident is labeled as mission critical
-	if(contains(incidentType->processingFlags,MISSION_CRITICAL_FLAG))
+	if(incidentType->flags & MISSION_CRITICAL_BIT)
 	{
 		isCriticalIncident = TRUE;
 	}
 	//checks if this incident is a possible critical incident
-	else if(contains(incidentType->processingFlags,CRITICAL_INCIDENT_FLAG) && !isCriticalIncident)
+	else if((incidentType->flags & CRITICAL_INCIDENT_BIT) && !isCriticalIncident)
 	{
 		char* filePath = calloc(STRING_LENGTH,sizeof(char));
 		constructLocalFilepath(filePath,OTHER,CRITICAL_INCIDENTS_FILE,DOT_TXT);
@@ -343,11 +494,11 @@ char* getHeaderLine(const struct IncidentType* incidentType){
   char *start, *end;
   
   //After finding the 1st pat, the headerLine takes on all characters before the 2nd pat
-  start = strstr(template, P1);
+  start = findSubstring(template, P1);
   if (start)
   {
     start += strlen( P1 );
-    end = strstr(start, P2);
+    end = findSubstring(start, P2);
     if (end)
     {
       headerLine = (char *)malloc(end-start+1);
@@ -400,7 +551,7 @@ void normalCaps(char *str){
 //	extra		-- any extra data (matches to the extra variable in the incident struct)
 //	whichLine	-- An int that tells the function which line it should format and return, either the event or location line.
 //	return		-- Returns a char pointer to the beginning of the formated string
-char* getFormatedLine(struct CCPair* ccPairLLHead, const struct IncidentType* incidentType,char* data,char* location,char* other,char* extra, int whichLine) {
+char* getFormatedLine(struct CCMapping* ccMapping, const struct IncidentType* incidentType,char* data,char* location,char* other,char* extra, int whichLine) {
 	char* eventLine = (char*)calloc(LONG_STRING_LENGTH,sizeof(char));
 	char* template;
 	//gets either the eventline template or location template depending on whichline
@@ -492,33 +643,23 @@ char* getFormatedLine(struct CCPair* ccPairLLHead, const struct IncidentType* in
 		}
 	}
 
-	if(contains(incidentType->processingFlags,GET_CAR_NUMBER_FLAG) == TRUE)
+	if(incidentType->flags & GET_CAR_NUMBER_BIT)
 	{
-		int carNum = getCarNum(atoi(data),ccPairLLHead);
+		int CC = atoi(data);
+		const struct CCPair* ccPair = findCCPair(CC,ccMapping);
 		
 		//append the car number or error message if the LUT search failed
 		char* temp = calloc(LONG_STRING_LENGTH,sizeof(char));
-		if(carNum == -1)
+		if(ccPair->carNum == NO_CAR_NUMBER)
 		{
 			//appends an error msg
-			sprintf(temp,"%s ERROR : CC # %d does not match any Car #",eventLine,atoi(data));
+			sprintf(temp,"%s ERROR : CC # %d does not match any Car #",eventLine,CC);
 		}
 		else
 		{
-			//appends the car #
-			if (atoi(data) < 100)
-			{
-				sprintf(temp,"%s (CAR NUMBER : %d).",eventLine,carNum);
-			}
-			else if ((atoi(data) < 119) && (atoi(data) > 109))
-			{
-				sprintf(temp,"%s (CAR NUMBER : RT-%d/%d).",eventLine,carNum,carNum+1);
-			}
-			else
-			{
-				sprintf(temp,"%s (CAR NUMBER : RT-%d).", eventLine,carNum);
-			}
-			}
+			//appends the car #, formatted when CC_Mapping.txt was read in
+			sprintf(temp,"%s (CAR NUMBER : %s).",eventLine,ccPair->carNumLabel);
+		}
 		//copy the string over to event line
 		int q = 0;
 		while(*(temp + q))
@@ -537,29 +678,19 @@ char* getFormatedLine(struct CCPair* ccPairLLHead, const struct IncidentType* in
 //RT-X/X VS RT-X VS TRX
 //Where X represents the car number
 //Used in addIncidentToEmail
-char* getCarNumString(char* data,struct CCPair* ccPairLLHead){
+char* getCarNumString(char* data,struct CCMapping* ccMapping){
 	char* carNumString  = (char*)calloc(STRING_LENGTH, sizeof(char)); 
-	int carNum = getCarNum(atoi(data),ccPairLLHead);
-	if( -1==carNum ) 
+	int CC = atoi(data);
+	const struct CCPair* ccPair = findCCPair(CC,ccMapping);
+	if( NO_CAR_NUMBER==ccPair->carNum ) 
 	{
 		//appends an error msg
-		sprintf(carNumString,"ERROR : CC # %d does not match any Car #",atoi(data));
+		sprintf(carNumString,"ERROR : CC # %d does not match any Car #",CC);
 	}
 	else 
 	{
-		//appends the car #
-		if (atoi(data) < 100) 
-		{
-			sprintf(carNumString,"TR%d",carNum);
-		}
-		else if ((atoi(data) < 119) && (atoi(data) > 109)) 
-		{
-			sprintf(carNumString,"RT-%d/%d",carNum,carNum+1);
-		}
-		else 
-		{
-			sprintf(carNumString,"RT-%d",carNum);
-		}
+		//copies the car #, formatted when CC_Mapping.txt was read in
+		strcpy(carNumString,ccPair->carNumString);
 	}
 	return carNumString;
 }
@@ -618,15 +749,16 @@ char* abrv(char* loc,char* data){
 //This algorithm splits the formated line & attemps to find \K
 //If successful, returns the whole token with \K
 char* fullNameFromPartial(char* data,char* formatedLine){
-	char *equipment = strtok(formatedLine," ");
+	char* save;
+	char *equipment = strtok_r(formatedLine," ",&save);
         while(equipment != NULL){
-          if(strstr(equipment,data)!=NULL) 
+          if(findSubstring(equipment,data)!=NULL) 
 	  {
 		return equipment;   
 	  }
 	  else
 	  {
-		  equipment = strtok(NULL," ");
+		  equipment = strtok_r(NULL," ",&save);
 	  }
 	}
 	return data;
@@ -634,11 +766,12 @@ char* fullNameFromPartial(char* data,char* formatedLine){
 /* Takes in an incident that will be emailed about and adds it to the subject line linked-list, if not already added.
   Gets the actual name of the incident and the actual location (CC# for onboard alarms, server name for server alarms)
   sl - the SubjectList linked-list containing all elements of the subject line
-  dr - the DatabaseRecord to be emailed about
-  it - the IncidentType matching the type of incident of dr */
+  location - the location of the DatabaseRecord to be emailed about
+  data - the data of the DatabaseRecord to be emailed about
+  it - the IncidentType matching the type of incident of the DatabaseRecord */
 
 void
-add_to_subject_line(struct SubjectList* sl, struct DatabaseRecord* dr, const struct IncidentType* it, struct CCPair* ccPairLLHead)
+add_to_subject_line(struct SubjectList* sl, char* location, char* data, const struct IncidentType* it, struct CCMapping* ccMapping)
 {
   char* name_of_incident = calloc(STRING_LENGTH, sizeof(char));
 
@@ -679,38 +812,39 @@ add_to_subject_line(struct SubjectList* sl, struct DatabaseRecord* dr, const str
     loc->location = (char*)calloc(STRING_LENGTH, sizeof(char));
     
     //If onboard incident, use CC #-Car # as location
-    if(contains(it->processingFlags, ONBOARD_INCIDENT_FLAG))
+    if(it->flags & ONBOARD_INCIDENT_BIT)
     {
-      int car = getCarNum(atoi(dr->data),ccPairLLHead);
+      int CC = atoi(data);
+      int car = getCarNum(CC,ccMapping);
 
-      if (atoi(dr->data) < 100)
+      if (CC < 100)
       {
-        sprintf(loc->location, "CC %s-TR%d", dr->data, car);
+        sprintf(loc->location, "CC %s-TR%d", data, car);
       }
-      else if (((atoi(dr->data) < 119) && (atoi(dr->data) > 109)) || atoi(dr->data) == 165)
+      else if (((CC < 119) && (CC > 109)) || CC == 165)
       {
-        sprintf(loc->location, "CC %s-RT%d/%d", dr->data, car, car+1);
+        sprintf(loc->location, "CC %s-RT%d/%d", data, car, car+1);
       }
-	  else if (atoi(dr->data) == 160)
+	  else if (CC == 160)
 	  {
-		sprintf(loc->location, "CC %s-RT%d/C1", dr->data, car);
+		sprintf(loc->location, "CC %s-RT%d/C1", data, car);
 	  }
       else
       {
-        sprintf(loc->location, "CC %s-RT%d", dr->data, car);
+        sprintf(loc->location, "CC %s-RT%d", data, car);
       }
 	
     }
       //If it's a server-related incident, use server name as location
-    else if(contains(it->processingFlags, SERVER_RELATED_INCIDENT))
+    else if(it->flags & SERVER_RELATED_INCIDENT_BIT)
     {
-      char* loc2abrv = abrv(dr->location,dr->data);
+      char* loc2abrv = abrv(location,data);
       strcpy(loc->location, loc2abrv);
       free(loc2abrv);
     }
     else
     {
-      char* loc2abrv = abrv(dr->location,NULL);
+      char* loc2abrv = abrv(location,NULL);
       strcpy(loc->location, loc2abrv);
       free(loc2abrv);
     }
@@ -728,10 +862,10 @@ add_to_subject_line(struct SubjectList* sl, struct DatabaseRecord* dr, const str
     while((NULL != temp_loc) && (FALSE == found))
     {
       //If onboard incident
-      if(contains(it->processingFlags, ONBOARD_INCIDENT_FLAG))
+      if(it->flags & ONBOARD_INCIDENT_BIT)
       {
         char* on_board_loc = calloc(STRING_LENGTH, sizeof(char));
-        sprintf(on_board_loc, "CC %s-", dr->data);
+        sprintf(on_board_loc, "CC %s-", data);
 
         if(contains(temp_loc->location, on_board_loc))
         {
@@ -740,7 +874,7 @@ add_to_subject_line(struct SubjectList* sl, struct DatabaseRecord* dr, const str
         free(on_board_loc);
       }
       else{
-       char* loc2abrv = abrv(dr->location,dr->data); 
+       char* loc2abrv = abrv(location,data); 
 
        //If server-related incident
        if(!strcmp(temp_loc->location, loc2abrv)) 
@@ -751,7 +885,7 @@ add_to_subject_line(struct SubjectList* sl, struct DatabaseRecord* dr, const str
        //If other incident type, compare just location
        else{ 
       	free(loc2abrv); 
-      	loc2abrv = abrv(dr->location,NULL);
+      	loc2abrv = abrv(location,NULL);
       	if(!strcmp(temp_loc->location,loc2abrv))
 		{
 		found = TRUE;
@@ -770,32 +904,33 @@ add_to_subject_line(struct SubjectList* sl, struct DatabaseRecord* dr, const str
       loc->location = (char*)calloc(STRING_LENGTH, sizeof(char));
       
       //If onboard incident, use CC #-Car # as location
-      if(contains(it->processingFlags, ONBOARD_INCIDENT_FLAG))
+      if(it->flags & ONBOARD_INCIDENT_BIT)
       {
-        int car = getCarNum(atoi(dr->data),ccPairLLHead);
-        if (atoi(dr->data) < 100)
+        int CC = atoi(data);
+        int car = getCarNum(CC,ccMapping);
+        if (CC < 100)
         {
-          sprintf(loc->location, "CC %s-TR%d", dr->data, car);
+          sprintf(loc->location, "CC %s-TR%d", data, car);
         }
-        else if (atoi(dr->data) < 117 && atoi(dr->data) > 109)
+        else if (CC < 117 && CC > 109)
         {
-          sprintf(loc->location, "CC %s-RT%d/%d", dr->data, car, car+1);
+          sprintf(loc->location, "CC %s-RT%d/%d", data, car, car+1);
         }
         else
         {
-          sprintf(loc->location, "CC %s-RT%d", dr->data, car);
+          sprintf(loc->location, "CC %s-RT%d", data, car);
         }
       }
         //If it's a server-related incident, use server name as location
-      else if(contains(it->processingFlags, SERVER_RELATED_INCIDENT))
+      else if(it->flags & SERVER_RELATED_INCIDENT_BIT)
       {
-      	char* loc2abrv = abrv(dr->location,dr->data);
+      	char* loc2abrv = abrv(location,data);
         strcpy(loc->location, loc2abrv);
       	free(loc2abrv);
       }
       else
       {
-      	char* loc2abrv = abrv(dr->location,NULL);
+      	char* loc2abrv = abrv(location,NULL);
         strcpy(loc->location, loc2abrv);
       	free(loc2abrv);
       }
@@ -1001,8 +1136,8 @@ print_subject_line(struct EmailInfo* ei)
 //   extra -- pointer to string in incident linked list node for extra data
 //   subwayLine -- pointer to string in incident linked list node for subway line (YUS, BDS, CYUS)
 //   locationString -- pointer to formatted string to be printed to notification email
-//   ccPairLLHead -- pointer to head of linked list for mapping CC number to TR/RT number
-void addIncidentToLogs(FILE* incidentLogs, char* isoString, struct IncidentType* incidentType, char* data, char* location, char* other, char* extra, char* subwayLine, char* locationString, struct CCPair* ccPairLLHead){
+//   ccMapping -- the table mapping CC number to TR/RT number, indexed by CC number
+void addIncidentToLogs(FILE* incidentLogs, char* isoString, struct IncidentType* incidentType, char* data, char* location, char* other, char* extra, char* subwayLine, char* locationString, struct CCMapping* ccMapping){
 	
 	
 	//Format of an incident (alarm) for telegraf to parse (grok and logfmt) and output to influxDB: ts=2020-02-28T11:00:05Z,incident_type=TF,...
@@ -1017,9 +1152,9 @@ void addIncidentToLogs(FILE* incidentLogs, char* isoString, struct IncidentType*
 	if (NULL != data && strcmp(data,"") != 0)
 	{
 		//If there is a processing flag for finding the car number (F), then the data variable (\K) contains the CC ID. 
-		if(contains(incidentType->processingFlags,GET_CAR_NUMBER_FLAG) == TRUE)
+		if(incidentType->flags & GET_CAR_NUMBER_BIT)
 		{
-			fprintf(incidentLogs, " CCID=\"%s\" car_number=\"%d\"", data, getCarNum(atoi(data),ccPairLLHead));
+			fprintf(incidentLogs, " CCID=\"%s\" car_number=\"%d\"", data, getCarNum(atoi(data),ccMapping));
 		}
 		else
 		{
@@ -1113,8 +1248,8 @@ void addIncidentToLogs(FILE* incidentLogs, char* isoString, struct IncidentType*
 
 // Print list of incidents to csv file for import into Log Aggregation System
 //   il -- Pointer to linked list containing incidents
-//   ccPairLLHead - Pointer to linked list mapping CC number to TR/RT number
-void printIncidentsToLogs(struct IncidentList* il, struct CCPair* ccPairLLHead){
+//   ccMapping - The table mapping CC number to TR/RT number, indexed by CC number
+void printIncidentsToLogs(struct IncidentList* il, struct CCMapping* ccMapping){
 	char* trackedIncidentsFilePath = (char*)calloc(STRING_LENGTH, sizeof(char));
 	constructLocalFilepath(trackedIncidentsFilePath, INCIDENT_LOGS, INCIDENT_LOGS_FILE, DOT_CSV);
 	FILE* incidentLogs = fopen(trackedIncidentsFilePath, "a");
@@ -1152,8 +1287,8 @@ void printIncidentsToLogs(struct IncidentList* il, struct CCPair* ccPairLLHead){
 
 			//ISO-8601: YYYY-MM-DD HH:mm:ss
 			char* isoString = getISOStringFromDate(tmp->timeElement->timeObj);
-			char* locationString = (char*)getFormatedLine(ccPairLLHead, tmp->incidentType, tmp->data,tmp->location,tmp->other,tmp->extra, LOCATION_LINE);
-			addIncidentToLogs(incidentLogs, isoString, tmp->incidentType, tmp->data, tmp->location, tmp->other, tmp->extra, tmp->subwayLine, locationString, ccPairLLHead);
+			char* locationString = (char*)getFormatedLine(ccMapping, tmp->incidentType, tmp->data,tmp->location,tmp->other,tmp->extra, LOCATION_LINE);
+			addIncidentToLogs(incidentLogs, isoString, tmp->incidentType, tmp->data, tmp->location, tmp->other, tmp->extra, tmp->subwayLine, locationString, ccMapping);
 			free(isoString);
 			free(locationString);
       tmp = tmp->next;
@@ -1169,22 +1304,24 @@ void printIncidentsToLogs(struct IncidentList* il, struct CCPair* ccPairLLHead){
 
 // If a database record has met threshold conditions, is not disabled and has 
 // not already been emailed about this method will take the information from a
-// database record and format it into a table in a html file associated
-// with each person is EmailInfoList 'el' who is supposed to receive emails 
-// about this type of incident
+// database record and format it into a table in the EmailFragment of each
+// person is EmailInfoList 'el' who is supposed to receive emails about this
+// type of incident. The fragments are added to the .html files associated with
+// each person by addEmailBufferToEmails
 //	dr		-- A record of an incident
 //	th		-- The threshold that was triggered to send the email
 //	el		-- The list of all possible email recipients
-//	start		-- The start time of the program
+//	eb		-- The EmailBuffer of the type of incident, with a fragment for each person in el
+//	start		-- The position in dr's time list of the first time that met the threshold
 //	incidentType	-- The type of incident that dr holds
 //	return		-- void
 void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th, 
-  struct EmailInfoList* el, struct TimeElement* start, const struct IncidentType* incidentType, struct CCPair* ccPairLLHead, bool headerExists) {
+  struct EmailInfoList* el, struct EmailBuffer* eb, int start, const struct IncidentType* incidentType, struct CCMapping* ccMapping, bool headerExists) {
   struct EmailInfo* tmp = el->head;
-  char* filePath = calloc(STRING_LENGTH, sizeof(char));
+  int recipient = 0;
   const struct IncidentType* incidentTypeCheck = NULL;
   //checks to see if a FCU event happened on line 3
-  if(contains(incidentType->processingFlags,CHECK_TCS_VHLC_SERVER_FLAG) == TRUE)
+  if(incidentType->flags & CHECK_TCS_VHLC_SERVER_BIT)
   {
   	incidentTypeCheck = checkIncidentName(dr->typeOfIncident, dr->location);
   }
@@ -1195,54 +1332,17 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
   }
   // while loop for EmailInfoList 'el' this list contains the information of
   // recipients who are supposed to receive emails 
-  while( tmp!=NULL) {
+  for( ; tmp!=NULL; tmp=tmp->next, recipient++) {
     // check if this person is supposed to receive emails about this type of
     // incident
-    if( shouldReceiveEmail(tmp,dr->typeOfIncident) == TRUE) {
-      constructLocalFilepath(filePath, EMAIL_INFO, tmp->bodyFileName, DOT_HTML);
-      
-      FILE* emailMsg = fopen(filePath, "r");
-
-      // check if emailMsg file is NULL, if so, create it.
-      if(emailMsg == NULL) {   // first entry, must create file 
-        tmp->sendEmail = TRUE;
-        
-        emailMsg = fopen(filePath, "w+");
-        if(NULL == emailMsg) {
-          printf("Cannot open email |%s| for write. Skipping.\n", filePath);
-          printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
-	        free(filePath);
-          return;
-        } 
-
-        add_to_subject_line(tmp->subject_list, dr, incidentType, ccPairLLHead);
-
-	fprintf(emailMsg, "Content-Type: text/html\n");
-	fprintf(emailMsg, "MIME-Version: 1.0\n\n");
-        fprintf(emailMsg, "<!DOCTYPE html>\n");
-        fprintf(emailMsg, "<style>body { font-family: \"Arial\", sans-serif; font-size: 14px; }\n table, th, td { border: 1px solid black; border-collapse: collapse; }\n td, th { padding-left: 0.625em; padding-right: 0.625em; line-height: 120%; text-align: center;}\nth { font-weight: bold; }\nsl { font-weight: bold; font-size:12pt;}\nimg {max-width: 17%%; height: auto;}</style><html><body>\n");
-	//fprintf(emailMsg, "<h1><br></h1>");
-      }
-      // if the file is not open, open it in 'append' mode
-      else {
-        tmp->sendEmail = TRUE;
-        if(EOF == fclose(emailMsg)) {
-          printf("Cannot close email |%s| from read. Skipping.\n", filePath);
-          printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
-	        free(filePath);
-          return;
-        }
-        emailMsg = fopen(filePath, "a");
-        if(NULL == emailMsg) {
-          printf("Cannot open email |%s| for appending. Skipping.\n", filePath);
-          printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
-	        free(filePath);
-          return;
-        }
+    if( shouldReceiveEmail(tmp,dr->typeId) == TRUE) {
+      struct EmailFragment* fragment = &eb->fragments[recipient];
+      FILE* emailMsg = getEmailFragmentStream(fragment);
+      if(NULL == emailMsg) {
+        return;
       }
 
-
-      add_to_subject_line(tmp->subject_list, dr, incidentType, ccPairLLHead);
+      addSubjectEntry(fragment, incidentType, dr->location, dr->data);
 
       // Brief descriptive message and table headings
       // <th> is table heading
@@ -1257,7 +1357,7 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
    	 char *headerLine = getHeaderLine(incidentType);
 
 	 //If the incident is Mission Critical, it will have an additional header
-   	 if(contains(incidentType->processingFlags,"M"))
+   	 if(incidentType->flags & MISSION_CRITICAL_BIT)
 	 {
 		 fprintf(emailMsg,"<font color=#bf0000><sl>CRITICAL INCIDENT</sl></font>\n<br>\n<sl style=\"color:#f20000\">%s</sl>\n<table style=\"color:#f20000\">",headerLine);
 	 }
@@ -1270,27 +1370,28 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
    	 //Tables have rows organized by the processing flags they carry
    	 //More specific rows are differentiated by non-empty/empty databaseRecord members 
    	 //Priority of flags is: TRVSMQFC -- based on incident types with colluding flags
-   	 if(contains(incidentType->processingFlags,"T"))
+   	 //compileProcessingFlags() picks the tableLayout from the flags in that order
+   	 if(incidentType->tableLayout == TABLE_LAYOUT_EXTENDED)
 	 {
 		 fprintf(emailMsg, "<tr> <th>Date</th> <th>Time</th> <th>Location</th> <th>%s</th> <th>Fault Cause</th> <th>Engineering Review</th> <th>Signals Remarks</th> </tr>\n",incidentType->object);
 	 }
 
-   	 else if(contains(incidentType->processingFlags,"R"))
+   	 else if(incidentType->tableLayout == TABLE_LAYOUT_REVENUE_HOURS)
 	 {
 		 fprintf(emailMsg, "<tr> <th>Date</th> <th>Time</th> <th>Location</th> </tr>\n");
 	 }
 
-   	 else if(contains(incidentType->processingFlags,"V"))
+   	 else if(incidentType->tableLayout == TABLE_LAYOUT_VHLC_CHANNEL)
 	 {
 		 fprintf(emailMsg, "<tr> <th>Date</th> <th>Time</th>  <th>Location</th> <th>Channel</th> </tr>\n");
 	 }
 
-   	 else if(contains(incidentType->processingFlags,"S"))
+   	 else if(incidentType->tableLayout == TABLE_LAYOUT_SERVER)
 	 {
 		 fprintf(emailMsg, "<tr> <th>Date</th> <th>Time</th> <th>Server</th> <th>Line</th> </tr>\n");
 	 }
 
-   	 else if(contains(incidentType->processingFlags,"M")) 
+   	 else if(incidentType->tableLayout == TABLE_LAYOUT_MISSION_CRITICAL) 
 	 {
 	
 	  //Non-empty/empty incident member variables deduce the table header
@@ -1304,12 +1405,13 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 		  }
 		  else
 		  {
-			   fprintf(emailMsg, "<tr> <th>Date</th> <th>Time</th> <th>Location</th> <th>%s</th></tr>\n",strtok(incidentType->object," - "));
-			   strcpy(incidentType->object,strtok(NULL," - "));
+			   char* objectSave;
+			   fprintf(emailMsg, "<tr> <th>Date</th> <th>Time</th> <th>Location</th> <th>%s</th></tr>\n",strtok_r(incidentType->object," - ",&objectSave));
+			   strcpy(incidentType->object,strtok_r(NULL," - ",&objectSave));
 		  }
    	 }
 
-   	 else if (contains(incidentType->processingFlags,"Q")) 
+   	 else if(incidentType->tableLayout == TABLE_LAYOUT_CONTROLLER) 
 	 {
 
     	   //Non-empty/empty incident member variables deduce the table header
@@ -1326,7 +1428,7 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
     	   }
         }
 
-        else if (contains(incidentType->processingFlags,"F")) 
+        else if(incidentType->tableLayout == TABLE_LAYOUT_CAR_NUMBER) 
 	{
 
 	  //Differentiation for UCCR incident type
@@ -1340,7 +1442,7 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 	  }	
         }
 
-        else if (contains(incidentType->processingFlags,"C")) 
+        else if(incidentType->tableLayout == TABLE_LAYOUT_CRITICAL) 
 	{
 	
        	//Table header may have a specific Equipment type (based on object) 
@@ -1381,33 +1483,34 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 
 	  
 	//Every incident is appended to the table of their corresponding type
-	struct TimeElement* te = start;
 	char* remoteLink;
         int i;
 	printf("numIncidents: %d\n", th->numOfIncidents);
-	for(i=0; i < th->numOfIncidents; i++) {
+	//a threshold checked on buckets of time may have fewer times kept
+	for(i=0; i < th->numOfIncidents && start + i < dr->timeList->count; i++) {
 		char* s;
-		char* timeString = strtok(s = getStringFromDate(te->timeObj), " ");
-		char* dateString = strtok(NULL, " ");
-		char* formatedLine = getFormatedLine(ccPairLLHead, incidentType, dr->data,dr->location,dr->other,dr->extra, LOCATION_LINE);
+		char* save;
+		char* timeString = strtok_r(s = getStringFromDate(getTime(dr->timeList, start + i)), " ", &save);
+		char* dateString = strtok_r(NULL, " ", &save);
+		char* formatedLine = getFormatedLine(ccMapping, incidentType, dr->data,dr->location,dr->other,dr->extra, LOCATION_LINE);
 
 	     //Tables have rows organized by the processing flags they carry
 	     //More specific rows are differentiated by non-empty/empty databaseRecord members 
 	     //Contents of incidents are appended based on priority ordering
-	     if (contains(incidentType->processingFlags,"T")) 
+	     if(incidentType->tableLayout == TABLE_LAYOUT_EXTENDED) 
 	     {
 	      char* Track = dr->data;
 	      char* loc = dr->location;
 	      fprintf(emailMsg, "<tr> <td>%s</td> <td>%s</td> <td>%s</td> <td>%s</td> <td></td> <td></td> <td></td> </tr>\n",dateString,timeString,loc,Track);
 	     }
 
-	     else if (contains(incidentType->processingFlags,"R"))
+	     else if(incidentType->tableLayout == TABLE_LAYOUT_REVENUE_HOURS)
 	     {
 	      char* loc = dr->location;
 	      fprintf(emailMsg, "<tr> <td>%s</td> <td>%s</td> <td>%s</td> </tr>\n",dateString,timeString,loc);
 	     }
 
-	     else if (contains(incidentType->processingFlags,"V")){ 
+	     else if(incidentType->tableLayout == TABLE_LAYOUT_VHLC_CHANNEL){ 
 	      char* loc = dr->location;
 	      char* channel = (char*)calloc(STRING_LENGTH, sizeof(char));
 
@@ -1426,7 +1529,7 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 	      free(channel);
 	      }
 
-	     else if (contains(incidentType->processingFlags,"S")) 
+	     else if(incidentType->tableLayout == TABLE_LAYOUT_SERVER) 
 	     {
 	      char* Server = (char*)calloc(STRING_LENGTH, sizeof(char));
 
@@ -1444,7 +1547,7 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 	      free(Server);
 	     }
 
-	     else if (contains(incidentType->processingFlags,"M")) 
+	     else if(incidentType->tableLayout == TABLE_LAYOUT_MISSION_CRITICAL) 
 	     {
 	      char* loc = dr->location;
 		
@@ -1470,7 +1573,7 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 	      }
 	     }
 
-	     else if (contains(incidentType->processingFlags,"Q")) 
+	     else if(incidentType->tableLayout == TABLE_LAYOUT_CONTROLLER) 
 	     {
 	      char* Controller = (char*)calloc(STRING_LENGTH, sizeof(char));
 	      char* Line = dr->other;
@@ -1498,11 +1601,11 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 	      }
 	      free(Controller);
 	     }
-	     else if (contains(incidentType->processingFlags,"F")) 
+	     else if(incidentType->tableLayout == TABLE_LAYOUT_CAR_NUMBER) 
 	     {
 	      char* CC = dr->data;
 	      char* loc = dr->location;
-	      char* TrainNum = getCarNumString(dr->data,ccPairLLHead);
+	      char* TrainNum = getCarNumString(dr->data,ccMapping);
 	      char* RunNum;
 	      if('\0'==*(dr->extra)) 
 	      {
@@ -1518,7 +1621,7 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 	      }
 	      free(TrainNum);
 	     }
-	     else if (contains(incidentType->processingFlags,"C"))
+	     else if(incidentType->tableLayout == TABLE_LAYOUT_CRITICAL)
 	     {
 	      char* loc = dr->location;
 	      char* critIncident = (char*)calloc(STRING_LENGTH, sizeof(char)); 
@@ -1587,7 +1690,6 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 	     } 
 	   }
 
-	te = te->next;
 	free(formatedLine);
 	free(s);
       } 
@@ -1601,16 +1703,80 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
       {
 	      ;//do nothing
       }
-      if( fclose(emailMsg) == EOF )
-      {
-        printf("There was an error with file: %s\n The file could not be closed by the program\n", tmp->bodyFileName);
-        printf("Cannot close emailtimediff l |%s| from read. Skipping.\n", filePath);
+    }
+  }
+}
+
+// Add the EmailFragments of one type of incident to the .html files associated
+// with each person in EmailInfoList 'el'. A file that does not exist yet is
+// created with the html header, and the incidents of each fragment are added
+// to the person's subject line in the order they were written. Called for the
+// types in the order of the IncidentTypeList, so the files are the same as if
+// every type had written to them in turn
+//	eb		-- The EmailBuffer of a type of incident, filled by addIncidentToEmail
+//	el		-- The list of all possible email recipients
+//	return		-- void
+void addEmailBufferToEmails(struct EmailBuffer* eb, struct EmailInfoList* el, struct CCMapping* ccMapping) {
+  struct EmailInfo* tmp = el->head;
+  int recipient = 0;
+  char* filePath = calloc(STRING_LENGTH, sizeof(char));
+
+  for( ; tmp!=NULL && recipient < eb->fragmentCount; tmp=tmp->next, recipient++) {
+    struct EmailFragment* fragment = &eb->fragments[recipient];
+    if(fragment->subjectHead == NULL) {
+      continue;
+    }
+    closeEmailFragment(fragment);
+    constructLocalFilepath(filePath, EMAIL_INFO, tmp->bodyFileName, DOT_HTML);
+    
+    FILE* emailMsg = fopen(filePath, "r");
+
+    // check if emailMsg file is NULL, if so, create it.
+    if(emailMsg == NULL) {   // first entry, must create file 
+      tmp->sendEmail = TRUE;
+      
+      emailMsg = fopen(filePath, "w+");
+      if(NULL == emailMsg) {
+        printf("Cannot open email |%s| for write. Skipping.\n", filePath);
+        printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
+        continue;
+      } 
+
+      fprintf(emailMsg, "Content-Type: text/html\n");
+      fprintf(emailMsg, "MIME-Version: 1.0\n\n");
+      fprintf(emailMsg, "<!DOCTYPE html>\n");
+      fprintf(emailMsg, "<style>body { font-family: \"Arial\", sans-serif; font-size: 14px; }\n table, th, td { border: 1px solid black; border-collapse: collapse; }\n td, th { padding-left: 0.625em; padding-right: 0.625em; line-height: 120%; text-align: center;}\nth { font-weight: bold; }\nsl { font-weight: bold; font-size:12pt;}\nimg {max-width: 17%%; height: auto;}</style><html><body>\n");
+    }
+    // if the file is not open, open it in 'append' mode
+    else {
+      tmp->sendEmail = TRUE;
+      if(EOF == fclose(emailMsg)) {
+        printf("Cannot close email |%s| from read. Skipping.\n", filePath);
         printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
+        continue;
       }
-      
+      emailMsg = fopen(filePath, "a");
+      if(NULL == emailMsg) {
+        printf("Cannot open email |%s| for appending. Skipping.\n", filePath);
+        printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
+        continue;
+      }
+    }
+
+    struct SubjectEntry* entry = fragment->subjectHead;
+    while(entry != NULL) {
+      add_to_subject_line(tmp->subject_list, entry->location, entry->data, entry->incidentType, ccMapping);
+      entry = entry->next;
     }
-    tmp=tmp->next;
 
+    fwrite(fragment->body, sizeof(char), fragment->length, emailMsg);
+
+    if( fclose(emailMsg) == EOF )
+    {
+      printf("There was an error with file: %s\n The file could not be closed by the program\n", tmp->bodyFileName);
+      printf("Cannot close emailtimediff l |%s| from read. Skipping.\n", filePath);
+      printf("errno = %d\n, strerror is %s\n", errno, strerror(errno));
+    }
   }
   free(filePath);
 }
@@ -1623,10 +1789,9 @@ void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th,
 //	el		-- Email list of all possible email recipients
 //	incidnetTypeList-- A list with all incidentTypes that were read in.
 //	return		-- void
-void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, struct IncidentTypeList* incidentTypeList, struct CCPair* ccPairLLHead) {
+void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, struct IncidentTypeList* incidentTypeList, struct CCMapping* ccMapping) {
     struct SummaryEmail* se = sel->head;
     struct EmailInfo* ei = el->head;
-    const struct IncidentType* incidentTypeListTraveller;
     char* command;
     
     while(NULL != se) {
@@ -1641,28 +1806,18 @@ void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, s
         }
         else {
             //make threshold list
-	    BOOL found = FALSE;
-	    incidentTypeListTraveller = incidentTypeList->head;
             struct ThresholdList* thresholdList;
 	    const struct IncidentType* incidentType;
-	    //find the incidentType that coresponds to the typeOfIncident string
-            while(!found && incidentTypeListTraveller != NULL)
-	    {
-		if(strcmp(se->typeOfIncident,incidentTypeListTraveller->typeOfIncident) == 0)
-		{
-			//get threshold from indcident type
-			thresholdList = incidentTypeListTraveller->thresholdList;
-			incidentType = incidentTypeListTraveller;
-			found = TRUE;
-		}
-		incidentTypeListTraveller = incidentTypeListTraveller->next;
-	    }
+	    //find the incidentType that coresponds to the type id of the summary email
 	    //if the incidentType could not be found
-	    if(!found)
+	    if(se->typeId == NO_TYPE_ID || se->typeId >= incidentTypeList->typeIdCount)
 	    {
 		printf("Error : Could not match typeOfIncident :%s: for Summary Incident Email \n",se->typeOfIncident);
 		return;
 	    }
+	    incidentType = incidentTypeList->byId[se->typeId];
+	    //get threshold from indcident type
+	    thresholdList = incidentType->thresholdList;
             
             //discover which threshold condition has been met
             struct DatabaseRecord* dr = malloc(sizeof(struct DatabaseRecord));
@@ -1671,15 +1826,18 @@ void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, s
             dr->other = se->other;
 	    dr->subwayLine = NULL;
             dr->typeOfIncident = se->typeOfIncident;
+            dr->typeId = se->typeId;
             dr->timeList = se->tl;
             
             struct Threshold* th_tmp = thresholdList->head;
-            struct TimeElement* start;
+            int start;
             int numOfIncidents = -1;
             int numOfMinutes = -1;
             int largestThresholdNumMinutes = th_tmp->numOfMinutes;
             while(NULL != th_tmp) {
-                int thresholdResult = checkSummaryThresholdCondition(th_tmp, dr, &start);
+                //the summary only holds times, thresholds checked on buckets are left out
+                int thresholdResult = th_tmp->bucketMinutes > 0 ? NO_CONDITION_MET :
+                  checkSummaryThresholdCondition(th_tmp, dr, &start);
                 if(CONDITION_MET == thresholdResult) {
                     numOfIncidents = th_tmp->numOfIncidents;
                     numOfMinutes = th_tmp->numOfMinutes;
@@ -1703,7 +1861,7 @@ void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, s
 		const struct IncidentType* incidentTypeCheck = NULL;
 
 		//checks to see if a FCU event happened on line 3
-		if(contains(incidentType->processingFlags,CHECK_TCS_VHLC_SERVER_FLAG) == TRUE)
+		if(incidentType->flags & CHECK_TCS_VHLC_SERVER_BIT)
 		{
 			incidentTypeCheck = checkIncidentName(dr->typeOfIncident, dr->location);
 		}
@@ -1718,14 +1876,14 @@ void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, s
 
                 //print destination email addresses to file
                  while(NULL != ei ) {
-                     if(typeOfIncidentListContain(ei->typeOfIncidentList, se->typeOfIncident)) {
+                     if(typeOfIncidentListContainId(ei->typeOfIncidentList, se->typeId)) {
                          fprintf(emailMsg, "%s, ", ei->personsEmail);
                      }
                      ei = ei->next;
                  }
                  ei = el->head;
 		//get subject line
-		char* subjectLine = getFormatedLine(ccPairLLHead, incidentType,se->data,se->location,se->other,se->extra,SUMMARY_LINE);
+		char* subjectLine = getFormatedLine(ccMapping, incidentType,se->data,se->location,se->other,se->extra,SUMMARY_LINE);
 		//print subject line
 		fprintf(emailMsg,"\nSubject: %s - Automated CSS Alarm Tool\n",subjectLine);
                 fprintf(emailMsg, "Content-Type: text/html\n");
@@ -1733,9 +1891,9 @@ void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, s
 		fprintf(emailMsg, "<!DOCTYPE html>\n");
                 fprintf(emailMsg, "<html><head><style>body { font-family: \"Arial\", sans-serif; font-size: 14px; }\n table, th, td { border: 1px solid black; border-collapse: collapse; }\n td, th { padding-left: 0.625em; padding-right: 0.625em; line-height: 120%; text-align: center; }\n th { font-weight: bold; }</style></head><body>");
 		//fprintf(emailMsg, "</h1>\n");
-                char* eventLine = getFormatedLine(ccPairLLHead, incidentType,se->data,se->location,se->other,se->extra,EVENT_LINE);
+                char* eventLine = getFormatedLine(ccMapping, incidentType,se->data,se->location,se->other,se->extra,EVENT_LINE);
 
-                if(contains(incidentType->processingFlags, ONBOARD_INCIDENT_FLAG))
+                if(incidentType->flags & ONBOARD_INCIDENT_BIT)
                 {
                   removeFirstChars(subjectLine, strlen("Summary For : "));
                   fprintf(emailMsg, subjectLine);
@@ -1750,7 +1908,7 @@ void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, s
                 fprintf(emailMsg, " %d incident(s) in %d hour(s) and %d minute(s).\n",
                         se->tl->count, (int)numOfMinutes / (int)60,(int)numOfMinutes % 60);
 
-                if(contains(incidentType->processingFlags, ONBOARD_INCIDENT_FLAG))
+                if(incidentType->flags & ONBOARD_INCIDENT_BIT)
                 {
                   fprintf(emailMsg, "<table><tr> <th>Date(MM/DD/YY)</th> <th>Time(24Hr)</th> <th>Location</th> </tr></b>\n");
                 }
@@ -1759,14 +1917,14 @@ void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, s
                   fprintf(emailMsg, "<table><tr> <th>Date(MM/DD/YY)</th> <th>Time(24Hr)</th> </tr></b>\n");
                 }
 
-                struct TimeElement* te = se->tl->head;
-                while(NULL != te) {
+                int t;
+                for(t = 0; t < se->tl->count; t++) {
                     char* s;
-                    char* timeString = strtok(s = getStringFromDate(te->timeObj), " ");
+                    char* timeString = strtok(s = getStringFromDate(getTime(se->tl, t)), " ");
                     char* dateString = strtok(NULL, " ");
-                    if(contains(incidentType->processingFlags, ONBOARD_INCIDENT_FLAG))
+                    if(incidentType->flags & ONBOARD_INCIDENT_BIT)
                     {
-                      fprintf(emailMsg, "<tr> <td>%s</td> <td>%s</td> <td>%s</td> </tr>\n", dateString, timeString, te->location);
+                      fprintf(emailMsg, "<tr> <td>%s</td> <td>%s</td> <td>%s</td> </tr>\n", dateString, timeString, getTimeLocation(se->tl, t));
                     }
                     else
                     {
@@ -1774,7 +1932,6 @@ void sendSummaryEmails(struct SummaryEmailList* sel, struct EmailInfoList* el, s
                     }
                     
                     free(s);
-                    te = te->next;
                 }
 
                 fprintf(emailMsg, "</table><hr><p>This is an automated message from the CSS Alarm Tool ");
@@ -1935,7 +2092,7 @@ int main() {
   }
   printf("%d Incident Types have been read in\n",incidentTypeList->count);
   printf("\nReading in CC mapping.\n");
-  struct CCPair* ccPairLLHead = readInCCMapping();
+  struct CCMapping* ccMapping = readInCCMapping();
   printf("CC mapping has been read in\n");
   // Current Time
   // Initially put in for debugging purposed to set date to June 14 - 16th, 
@@ -1971,6 +2128,13 @@ int main() {
   struct EmailInfoList* emailInfoList = malloc(sizeof(struct EmailInfoList));
   createEmailInfoList(emailInfoList);
   readInEmailInfoFile(emailInfoList);
+  // each recipient is sent emails about the types in the type bitset of its EmailInfo
+  struct EmailInfo* emailInfoTraveller = emailInfoList->head;
+  while(emailInfoTraveller != NULL)
+  {
+    buildTypeOfIncidentBits(emailInfoTraveller->typeOfIncidentList, incidentTypeList);
+    emailInfoTraveller = emailInfoTraveller->next;
+  }
 
   printf("Email Recipients List\n");
   
@@ -2002,7 +2166,7 @@ int main() {
   
   printf("Incident List\n");
   printIncidentList(incidentList, NULL);
-  printIncidentsToLogs(incidentList, ccPairLLHead);
+  printIncidentsToLogs(incidentList, ccMapping);
   printf("\n");
    
   
@@ -2014,14 +2178,8 @@ int main() {
   // exceed a threshold condition the information from the database is added
   // to the .html email file of each person in 'emailInfoList' (see above) who
   // is supposed to get email about this type of incident
-  struct IncidentType* incidentTypeListTraveller = incidentTypeList->head;
-
-
-  while(incidentTypeListTraveller != NULL)
-  {  
-      processInfo(incidentTypeListTraveller->typeOfIncident,incidentList,emailInfoList,sel,incidentTypeListTraveller,ccPairLLHead);
-  	incidentTypeListTraveller = incidentTypeListTraveller->next;
-  }
+  // The types are processed on a pool of threads, see processIncidentTypes
+  processIncidentTypes(incidentTypeList,incidentList,emailInfoList,sel,ccMapping);
 
   // Finish emails
   struct EmailInfo* ei = emailInfoList->head;
@@ -2063,7 +2221,7 @@ int main() {
   }
   //send out summary emails now
   printf("Summary list count: %d\n", getCountOfSummaryEmailList(sel));
-  sendSummaryEmails(sel, emailInfoList,incidentTypeList, ccPairLLHead);
+  sendSummaryEmails(sel, emailInfoList,incidentTypeList, ccMapping);
   //free things
   destroySummaryEmailList(sel);
   destroyEmailInfoList(emailInfoList);  
@@ -2072,7 +2230,7 @@ int main() {
 	  writeTimeOfLastEmail(t);
   }
   deleteIncidentTypeList(incidentTypeList);
-  deleteCCPairList(ccPairLLHead);
+  deleteCCMapping(ccMapping);
   free(command);
   free(filePath);
   free(abrvPath);
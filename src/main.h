@@ -2,6 +2,8 @@
 #ifndef MAIN_H
 #define MAIN_H
 
-void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th, struct EmailInfoList* el, struct TimeElement* start, const struct IncidentType* incidentType, struct CCPair* ccPairLLHead, bool headerExists);
+void addIncidentToEmail(struct DatabaseRecord* dr, struct Threshold* th, struct EmailInfoList* el, struct EmailBuffer* eb, int start, const struct IncidentType* incidentType, struct CCMapping* ccMapping, bool headerExists);
+
+void addEmailBufferToEmails(struct EmailBuffer* eb, struct EmailInfoList* el, struct CCMapping* ccMapping);
 
 #endif